@@ -10,7 +10,7 @@ public class CompDep : ModuleRules
 		
 		PublicDependencyModuleNames.AddRange(
 			[
-				"Core", "CoreUObject", "Engine"
+				"Core", "CoreUObject", "Engine", "GameplayTags"
 			]
 		);
 	}
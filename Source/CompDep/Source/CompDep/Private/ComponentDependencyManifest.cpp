@@ -0,0 +1,277 @@
+﻿#include "ComponentDependencyManifest.h"
+
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCompDepManifest, Log, All);
+
+namespace
+{
+	constexpr uint32 ManifestMagic{ 0x4D504443 }; // "CDPM"
+	constexpr int32 ManifestVersion{ 2 };
+
+	bool AreIndicesValid(const TArray<int32>& Indices, int32 Count)
+	{
+		for (const int32 index : Indices)
+		{
+			if (index < 0 || index >= Count) { return false; }
+		}
+		return true;
+	}
+
+	template <typename TEnum>
+	bool AreEnumValuesValid(const TArray<uint8>& Values)
+	{
+		const UEnum* enumType{ StaticEnum<TEnum>() };
+		for (const uint8 value : Values)
+		{
+			if (!enumType->IsValidEnumValue(value)) { return false; }
+		}
+		return true;
+	}
+}
+
+FComponentDependencyManifest& FComponentDependencyManifest::Get()
+{
+	static FComponentDependencyManifest manifest{};
+	static bool attemptedLoad{ false };
+
+	if (!attemptedLoad)
+	{
+		attemptedLoad = true;
+		const FString path{ GetManifestPath() };
+		if (!manifest.LoadFromFile(path) && FPaths::FileExists(path))
+		{
+			UE_LOG(LogCompDepManifest, Warning, TEXT("Rejected stale or corrupt component dependency manifest %s; rebuild it by cooking, with the CompDepManifest commandlet or the CompDep.RebuildManifest console command."), *path);
+		}
+	}
+
+	return manifest;
+}
+
+FString FComponentDependencyManifest::GetManifestPath()
+{
+	return FPaths::ProjectContentDir() / TEXT("CompDep/ComponentDependencies.manifest");
+}
+
+void FComponentDependencyManifest::Reset()
+{
+	*this = FComponentDependencyManifest{};
+}
+
+void FComponentDependencyManifest::AddClass(const UClass* Class, const TArray<FComponentDependency>& Dependencies)
+{
+	check(Class);
+
+	const FTopLevelAssetPath classPath{ Class->GetClassPathName() };
+	if (DeclaringLookup.Contains(classPath)) { return; }
+
+	DeclaringLookup.Add(classPath, DeclaringClasses.Num());
+	DeclaringClasses.Add(AddClassPath(classPath));
+
+	for (const FComponentDependency& dependency : Dependencies)
+	{
+		if (!dependency.HasClass()) { continue; }
+
+		Positions.Add(static_cast<uint8>(dependency.Position));
+		Types.Add(static_cast<uint8>(dependency.Type));
+		DependencyClasses.Add(AddClassPath(dependency.GetClassPath()));
+		DependencyTags.Add(AddTag(dependency.Meta));
+		DependencyTagQueries.Add(dependency.TagQuery);
+	}
+
+	FirstDependency.Add(Positions.Num());
+}
+
+bool FComponentDependencyManifest::LoadFromFile(const FString& Path)
+{
+	TArray<uint8> bytes{};
+	if (!FFileHelper::LoadFileToArray(bytes, *Path, FILEREAD_Silent)) { return false; }
+
+	FComponentDependencyManifest loaded{};
+	FMemoryReader reader{ bytes };
+	reader << loaded;
+	if (reader.IsError()) { return false; }
+
+	*this = MoveTemp(loaded);
+	return true;
+}
+
+bool FComponentDependencyManifest::SaveToFile(const FString& Path) const
+{
+	TArray<uint8> bytes{};
+	FMemoryWriter writer{ bytes };
+	// Serialization is symmetric, so it can't take a const manifest
+	writer << const_cast<FComponentDependencyManifest&>(*this);
+
+	return FFileHelper::SaveArrayToFile(bytes, *Path);
+}
+
+bool FComponentDependencyManifest::FindDependencies(const UClass* Class, TArray<FComponentDependency>& OutDependencies) const
+{
+	for (const UClass* curClass{ Class }; curClass; curClass = curClass->GetSuperClass())
+	{
+		const int32* declaringIndex{ DeclaringLookup.Find(curClass->GetClassPathName()) };
+		if (!declaringIndex) { continue; }
+
+		const int32 first{ FirstDependency[*declaringIndex] };
+		const int32 last{ FirstDependency[*declaringIndex + 1] };
+
+		OutDependencies.Reset(last - first);
+		for (int32 i{ first }; i < last; ++i)
+		{
+			FComponentDependency& dependency{ OutDependencies.AddDefaulted_GetRef() };
+			dependency.Position = static_cast<EComponentDependencyPosition>(Positions[i]);
+			dependency.Type = static_cast<EComponentDependencyType>(Types[i]);
+			dependency.Class = ResolveClass(DependencyClasses[i]);
+			dependency.SoftClass = TSoftClassPtr<UActorComponent>{ FSoftObjectPath{ ClassPaths[DependencyClasses[i]] } };
+			dependency.Meta = Tags[DependencyTags[i]];
+			dependency.TagQuery = DependencyTagQueries[i];
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+FArchive& operator<<(FArchive& Ar, FComponentDependencyManifest& Manifest)
+{
+	uint32 magic{ ManifestMagic };
+	int32 version{ ManifestVersion };
+	Ar << magic;
+	Ar << version;
+
+	if (Ar.IsLoading() && (magic != ManifestMagic || version != ManifestVersion))
+	{
+		Ar.SetError();
+		return Ar;
+	}
+
+	// Stored as plain strings; a raw archive has no name table to resolve FNames against
+	TArray<FString> classPathStrings{};
+	TArray<FString> tagStrings{};
+	TArray<FString> tagQueryStrings{};
+	if (Ar.IsSaving())
+	{
+		for (const FTopLevelAssetPath& path : Manifest.ClassPaths) { classPathStrings.Add(path.ToString()); }
+		for (const FName& tag : Manifest.Tags) { tagStrings.Add(tag.ToString()); }
+		for (const FGameplayTagQuery& query : Manifest.DependencyTagQueries)
+		{
+			FString& queryString{ tagQueryStrings.AddDefaulted_GetRef() };
+			if (query.IsEmpty()) { continue; }
+			FGameplayTagQuery::StaticStruct()->ExportText(queryString, &query, nullptr, nullptr, PPF_None, nullptr);
+		}
+	}
+
+	Ar << classPathStrings;
+	Ar << tagStrings;
+	Ar << Manifest.DeclaringClasses;
+	Ar << Manifest.FirstDependency;
+	Ar << Manifest.Positions;
+	Ar << Manifest.Types;
+	Ar << Manifest.DependencyClasses;
+	Ar << Manifest.DependencyTags;
+	Ar << tagQueryStrings;
+
+	if (Ar.IsLoading())
+	{
+		const int32 dependencyCount{ Manifest.Positions.Num() };
+		const bool consistent{
+			!Ar.IsError()
+			&& Manifest.FirstDependency.Num() == Manifest.DeclaringClasses.Num() + 1
+			&& Manifest.FirstDependency[0] == 0
+			&& Manifest.FirstDependency.Last() == dependencyCount
+			&& Manifest.Types.Num() == dependencyCount
+			&& Manifest.DependencyClasses.Num() == dependencyCount
+			&& Manifest.DependencyTags.Num() == dependencyCount
+			&& tagQueryStrings.Num() == dependencyCount
+			&& AreIndicesValid(Manifest.DeclaringClasses, classPathStrings.Num())
+			&& AreIndicesValid(Manifest.DependencyClasses, classPathStrings.Num())
+			&& AreIndicesValid(Manifest.DependencyTags, tagStrings.Num())
+			&& AreEnumValuesValid<EComponentDependencyPosition>(Manifest.Positions)
+			&& AreEnumValuesValid<EComponentDependencyType>(Manifest.Types)
+		};
+
+		// Dependency ranges have to be in order, or FindDependencies would read past the arrays
+		bool rangesValid{ consistent };
+		for (int32 i{ 1 }; rangesValid && i < Manifest.FirstDependency.Num(); ++i)
+		{
+			rangesValid = Manifest.FirstDependency[i] >= Manifest.FirstDependency[i - 1];
+		}
+
+		if (!consistent || !rangesValid)
+		{
+			Ar.SetError();
+			return Ar;
+		}
+
+		Manifest.ClassPaths.Reset(classPathStrings.Num());
+		for (const FString& pathString : classPathStrings)
+		{
+			FTopLevelAssetPath& path{ Manifest.ClassPaths.AddDefaulted_GetRef() };
+			path.TrySetPath(pathString);
+		}
+
+		Manifest.Tags.Reset(tagStrings.Num());
+		for (const FString& tagString : tagStrings) { Manifest.Tags.Add(FName{ *tagString }); }
+
+		Manifest.DependencyTagQueries.Reset(tagQueryStrings.Num());
+		for (const FString& queryString : tagQueryStrings)
+		{
+			FGameplayTagQuery& query{ Manifest.DependencyTagQueries.AddDefaulted_GetRef() };
+			if (queryString.IsEmpty()) { continue; }
+			FGameplayTagQuery::StaticStruct()->ImportText(*queryString, &query, nullptr, PPF_None, nullptr, FGameplayTagQuery::StaticStruct()->GetName());
+		}
+
+		Manifest.RebuildLookups();
+	}
+
+	return Ar;
+}
+
+int32 FComponentDependencyManifest::AddClassPath(const FTopLevelAssetPath& Path)
+{
+	if (const int32* existing{ ClassPathLookup.Find(Path) }) { return *existing; }
+
+	const int32 index{ ClassPaths.Add(Path) };
+	ClassPathLookup.Add(Path, index);
+	return index;
+}
+
+int32 FComponentDependencyManifest::AddTag(FName Tag)
+{
+	if (const int32* existing{ TagLookup.Find(Tag) }) { return *existing; }
+
+	const int32 index{ Tags.Add(Tag) };
+	TagLookup.Add(Tag, index);
+	return index;
+}
+
+UClass* FComponentDependencyManifest::ResolveClass(int32 ClassIndex) const
+{
+	if (ResolvedClasses.Num() != ClassPaths.Num()) { ResolvedClasses.SetNum(ClassPaths.Num()); }
+
+	if (UClass* resolved{ ResolvedClasses[ClassIndex].Get() }) { return resolved; }
+
+	// A dependency class that isn't loaded can't have any instances either, so don't force a load
+	UClass* found{ FindObject<UClass>(ClassPaths[ClassIndex]) };
+	ResolvedClasses[ClassIndex] = found;
+	return found;
+}
+
+void FComponentDependencyManifest::RebuildLookups()
+{
+	ClassPathLookup.Reset();
+	for (int32 i{}; i < ClassPaths.Num(); ++i) { ClassPathLookup.Add(ClassPaths[i], i); }
+
+	TagLookup.Reset();
+	for (int32 i{}; i < Tags.Num(); ++i) { TagLookup.Add(Tags[i], i); }
+
+	DeclaringLookup.Reset();
+	for (int32 i{}; i < DeclaringClasses.Num(); ++i) { DeclaringLookup.Add(ClassPaths[DeclaringClasses[i]], i); }
+
+	ResolvedClasses.Reset();
+}
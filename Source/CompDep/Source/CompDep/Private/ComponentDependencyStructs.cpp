@@ -0,0 +1,38 @@
+﻿#include "ComponentDependencyStructs.h"
+
+bool FComponentDependency::HasClass() const
+{
+	return Class != nullptr || !SoftClass.IsNull();
+}
+
+FTopLevelAssetPath FComponentDependency::GetClassPath() const
+{
+	if (Class) { return Class->GetClassPathName(); }
+	return SoftClass.ToSoftObjectPath().GetAssetPath();
+}
+
+FString FComponentDependency::GetClassName() const
+{
+	if (Class) { return Class->GetName(); }
+	return SoftClass.GetAssetName();
+}
+
+bool FComponentDependency::IsSatisfiedByClass(const UClass* ComponentClass) const
+{
+	if (!ComponentClass) { return false; }
+	if (Class) { return ComponentClass->IsChildOf(Class); }
+	if (SoftClass.IsNull()) { return false; }
+
+	// Already loaded anyway; IsChildOf is cheaper than comparing paths
+	if (const UClass* loadedClass{ SoftClass.Get() }) { return ComponentClass->IsChildOf(loadedClass); }
+
+	// The component class is loaded, so its super chain is the authoritative hierarchy. If the dependency
+	// class isn't loaded, nothing can derive from it except through that chain, by path.
+	const FTopLevelAssetPath dependencyPath{ SoftClass.ToSoftObjectPath().GetAssetPath() };
+	for (const UClass* curClass{ ComponentClass }; curClass; curClass = curClass->GetSuperClass())
+	{
+		if (curClass->GetClassPathName() == dependencyPath) { return true; }
+	}
+
+	return false;
+}
@@ -18,6 +18,15 @@ COMPDEP_IMPL_OVERRIDE_DEPS_BEGIN(ULuhorMovementComponent)
 COMPDEP_IMPL_END
 
  * These will then be displayed in the editor when selecting the component in a blueprint.
+ *
+ * To avoid loading the dependency class whenever the declaring class loads (e.g. for Blueprint components),
+ * declare it softly by path instead:
+
+	COMPDEP_SOFTDEP_AnyOnActorRequired("/Game/Components/BP_Hittable.BP_Hittable_C")
+
+ * To match component tags hierarchically as gameplay tags, pass a FGameplayTagQuery:
+
+	COMPDEP_DEP_AnyOnActorWithTagQueryRequired(UWeaponComponent, FGameplayTagQuery::MakeQuery_MatchAnyTags(FGameplayTagContainer{ TAG_Weapon }))
  */
 
 #pragma region Helper Macros
@@ -66,6 +75,30 @@ dependencies.Add({ EComponentDependencyPosition::AnyOnActor, DependencyClass::St
 #define COMPDEP_DEP_ChildWithTagOptional(DependencyClass, Tag) \
 	dependencies.Add({ EComponentDependencyPosition::ChildWithTag, DependencyClass::StaticClass(), Tag, EComponentDependencyType::Optional });
 
+#define COMPDEP_DEP_AnyOnActorWithTagQueryRequired(DependencyClass, Query) \
+	dependencies.Add({ EComponentDependencyPosition::AnyOnActorWithTagQuery, DependencyClass::StaticClass(), "", EComponentDependencyType::Required, {}, Query });
+
+#define COMPDEP_DEP_AnyOnActorWithTagQueryOptional(DependencyClass, Query) \
+	dependencies.Add({ EComponentDependencyPosition::AnyOnActorWithTagQuery, DependencyClass::StaticClass(), "", EComponentDependencyType::Optional, {}, Query });
+
+#define COMPDEP_DEP_ChildWithTagQueryRequired(DependencyClass, Query) \
+	dependencies.Add({ EComponentDependencyPosition::ChildWithTagQuery, DependencyClass::StaticClass(), "", EComponentDependencyType::Required, {}, Query });
+
+#define COMPDEP_DEP_ChildWithTagQueryOptional(DependencyClass, Query) \
+	dependencies.Add({ EComponentDependencyPosition::ChildWithTagQuery, DependencyClass::StaticClass(), "", EComponentDependencyType::Optional, {}, Query });
+
+#define COMPDEP_SOFTDEP_IMPL(Position, ClassPath, Tag, Type) \
+	dependencies.Add({ EComponentDependencyPosition::Position, nullptr, Tag, EComponentDependencyType::Type, TSoftClassPtr<UActorComponent>{ FSoftObjectPath{ TEXT(ClassPath) } } });
+
+#define COMPDEP_SOFTDEP_AnyOnActorRequired(ClassPath) COMPDEP_SOFTDEP_IMPL(AnyOnActor, ClassPath, "", Required)
+#define COMPDEP_SOFTDEP_AnyOnActorOptional(ClassPath) COMPDEP_SOFTDEP_IMPL(AnyOnActor, ClassPath, "", Optional)
+#define COMPDEP_SOFTDEP_AnyOnActorWithTagRequired(ClassPath, Tag) COMPDEP_SOFTDEP_IMPL(AnyOnActorWithTag, ClassPath, Tag, Required)
+#define COMPDEP_SOFTDEP_AnyOnActorWithTagOptional(ClassPath, Tag) COMPDEP_SOFTDEP_IMPL(AnyOnActorWithTag, ClassPath, Tag, Optional)
+#define COMPDEP_SOFTDEP_ChildRequired(ClassPath) COMPDEP_SOFTDEP_IMPL(Child, ClassPath, "", Required)
+#define COMPDEP_SOFTDEP_ChildOptional(ClassPath) COMPDEP_SOFTDEP_IMPL(Child, ClassPath, "", Optional)
+#define COMPDEP_SOFTDEP_ChildWithTagRequired(ClassPath, Tag) COMPDEP_SOFTDEP_IMPL(ChildWithTag, ClassPath, Tag, Required)
+#define COMPDEP_SOFTDEP_ChildWithTagOptional(ClassPath, Tag) COMPDEP_SOFTDEP_IMPL(ChildWithTag, ClassPath, Tag, Optional)
+
 
 #else
 #define COMPDEP_IMPL_START(ClassName) COMPDEP_IMPL_OVERRIDE_DEPS_BEGIN(ClassName)
@@ -81,6 +114,19 @@ dependencies.Add({ EComponentDependencyPosition::AnyOnActor, DependencyClass::St
 #define COMPDEP_DEP_ChildOptional(DependencyClass)
 #define COMPDEP_DEP_ChildWithTagRequired(DependencyClass, Tag)
 #define COMPDEP_DEP_ChildWithTagOptional(DependencyClass, Tag)
+#define COMPDEP_DEP_AnyOnActorWithTagQueryRequired(DependencyClass, Query)
+#define COMPDEP_DEP_AnyOnActorWithTagQueryOptional(DependencyClass, Query)
+#define COMPDEP_DEP_ChildWithTagQueryRequired(DependencyClass, Query)
+#define COMPDEP_DEP_ChildWithTagQueryOptional(DependencyClass, Query)
+
+#define COMPDEP_SOFTDEP_AnyOnActorRequired(ClassPath)
+#define COMPDEP_SOFTDEP_AnyOnActorOptional(ClassPath)
+#define COMPDEP_SOFTDEP_AnyOnActorWithTagRequired(ClassPath, Tag)
+#define COMPDEP_SOFTDEP_AnyOnActorWithTagOptional(ClassPath, Tag)
+#define COMPDEP_SOFTDEP_ChildRequired(ClassPath)
+#define COMPDEP_SOFTDEP_ChildOptional(ClassPath)
+#define COMPDEP_SOFTDEP_ChildWithTagRequired(ClassPath, Tag)
+#define COMPDEP_SOFTDEP_ChildWithTagOptional(ClassPath, Tag)
 #endif
 #pragma endregion
 
@@ -0,0 +1,63 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "ComponentDependencyStructs.h"
+
+/*
+ * Flat table of the dependencies every IComponentDependencies class declares.
+ * It's baked by the editor when cooking and loaded at runtime with a single file read, so runtime code
+ * can look up a class's dependencies without calling GetDependencies; outside of the editor, the C++
+ * macros yield nothing and Blueprint implementations would have to run in the VM.
+ *
+ * For packaged builds, stage the manifest by adding the "CompDep" content directory to
+ * "Additional Non-Asset Directories to Package" in the project's packaging settings.
+ */
+class COMPDEP_API FComponentDependencyManifest
+{
+public:
+	// Loaded from GetManifestPath() on first access
+	static FComponentDependencyManifest& Get();
+	static FString GetManifestPath();
+
+	void Reset();
+	void AddClass(const UClass* Class, const TArray<FComponentDependency>& Dependencies);
+
+	bool LoadFromFile(const FString& Path);
+	bool SaveToFile(const FString& Path) const;
+
+	// Finds the dependencies declared by the given class, or by its closest ancestor in the manifest.
+	// Returns false if neither the class nor any ancestor is in the manifest.
+	// Dependency classes are never loaded by this; ones that aren't loaded yet only have SoftClass set.
+	bool FindDependencies(const UClass* Class, TArray<FComponentDependency>& OutDependencies) const;
+
+	int32 Num() const { return DeclaringClasses.Num(); }
+
+	friend FArchive& operator<<(FArchive& Ar, FComponentDependencyManifest& Manifest);
+
+private:
+	int32 AddClassPath(const FTopLevelAssetPath& Path);
+	int32 AddTag(FName Tag);
+	UClass* ResolveClass(int32 ClassIndex) const;
+	void RebuildLookups();
+
+	// Interned class paths and tags; everything else refers to them by index
+	TArray<FTopLevelAssetPath> ClassPaths{};
+	TArray<FName> Tags{};
+
+	// Per declaring class. Dependencies of declaring class i are [FirstDependency[i], FirstDependency[i + 1])
+	TArray<int32> DeclaringClasses{};
+	TArray<int32> FirstDependency{ 0 };
+
+	// Per dependency
+	TArray<uint8> Positions{};
+	TArray<uint8> Types{};
+	TArray<int32> DependencyClasses{};
+	TArray<int32> DependencyTags{};
+	TArray<FGameplayTagQuery> DependencyTagQueries{};
+
+	// Derived from the arrays above; not serialized
+	TMap<FTopLevelAssetPath, int32> ClassPathLookup{};
+	TMap<FName, int32> TagLookup{};
+	TMap<FTopLevelAssetPath, int32> DeclaringLookup{};
+	mutable TArray<TWeakObjectPtr<UClass>> ResolvedClasses{};
+};
@@ -1,6 +1,8 @@
 ﻿#pragma once
 
 #include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "UObject/SoftObjectPtr.h"
 #include "ComponentDependencyStructs.generated.h"
 
 UENUM(BlueprintType)
@@ -17,10 +19,12 @@ enum class EComponentDependencyPosition : uint8
 	AnyOnActorWithTag UMETA(ToolTip="Fulfilled if any component of the given type with the given tag exists on the actor"),
 	Child UMETA(ToolTip="Fulfilled if the SceneComponent has a child of the given type"),
 	ChildWithTag UMETA(ToolTip="Fulfilled if the SceneComponent has a child of the given type with the given tag"),
+	AnyOnActorWithTagQuery UMETA(ToolTip="Fulfilled if any component of the given type whose tags match the tag query exists on the actor"),
+	ChildWithTagQuery UMETA(ToolTip="Fulfilled if the SceneComponent has a child of the given type whose tags match the tag query"),
 };
 
 USTRUCT(BlueprintType)
-struct FComponentDependency
+struct COMPDEP_API FComponentDependency
 {
 	GENERATED_BODY()
 
@@ -35,4 +39,22 @@ struct FComponentDependency
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	EComponentDependencyType Type{ EComponentDependencyType::Required };
+
+	// Used instead of Class when that's empty. Declaring a dependency softly means the dependency class
+	// (and everything it references) isn't loaded along with the declaring class.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TSoftClassPtr<UActorComponent> SoftClass{};
+
+	// Used by the WithTagQuery positions. Component tags are read as gameplay tags, so matching is
+	// hierarchical: a query for "Weapon" also matches a component tagged "Weapon.Rifle".
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FGameplayTagQuery TagQuery{};
+
+	bool HasClass() const;
+	FTopLevelAssetPath GetClassPath() const;
+	FString GetClassName() const;
+
+	// Whether a component of the given class fulfills this dependency's type requirement.
+	// Soft classes are matched by path along the component class's own hierarchy, so they never get loaded.
+	bool IsSatisfiedByClass(const UClass* ComponentClass) const;
 };
\ No newline at end of file
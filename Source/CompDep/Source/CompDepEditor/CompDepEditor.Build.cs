@@ -20,9 +20,16 @@ public class CompDepEditor : ModuleRules
 			new string[] {
 				"CoreUObject",
 				"Engine",
+				"GameplayTags",
+				"DeveloperSettings",
+				"MessageLog",
+				"CollectionManager",
+				"Settings",
 				"Slate",
 				"SlateCore",
 				"UnrealEd",
+				"KismetCompiler",
+				"EditorSubsystem",
 				"ToolMenus",
 				"Blutility",
 				"UMG",
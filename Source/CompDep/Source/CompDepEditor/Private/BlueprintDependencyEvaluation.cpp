@@ -0,0 +1,124 @@
+#include "BlueprintDependencyEvaluation.h"
+
+#include "Engine/BlueprintGeneratedClass.h"
+
+TSharedRef<FBlueprintDependencyEvaluation> FBlueprintDependencyEvaluation::Create(UBlueprintGeneratedClass* BlueprintGC)
+{
+    TSharedRef<FBlueprintDependencyEvaluation> evaluation{ MakeShared<FBlueprintDependencyEvaluation>() };
+    evaluation->BlueprintGC = BlueprintGC;
+    evaluation->BindChangeHooks();
+    return evaluation;
+}
+
+FBlueprintDependencyEvaluation::~FBlueprintDependencyEvaluation()
+{
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+
+    for (const FObservedBlueprint& observed : ObservedBlueprints)
+    {
+        UBlueprint* blueprint{ observed.Blueprint.Get() };
+        if (!blueprint) { continue; }
+
+        blueprint->OnChanged().Remove(observed.ChangedHandle);
+        blueprint->OnCompiled().Remove(observed.CompiledHandle);
+    }
+}
+
+int32 FBlueprintDependencyEvaluation::AddDependency(const UActorComponent* SourceComponent, const FComponentDependency& Dependency)
+{
+    check(FDependencyUtils::GetOwningBlueprintClass(SourceComponent) == BlueprintGC.Get());
+
+    FEntry& entry{ Entries.AddDefaulted_GetRef() };
+    entry.Component = SourceComponent;
+    entry.Dependency = Dependency;
+    return Entries.Num() - 1;
+}
+
+const FDependencyFulfilledResult& FBlueprintDependencyEvaluation::GetResult(int32 Index)
+{
+    check(Entries.IsValidIndex(Index));
+
+    // Any dirty entry triggers recomputation of all dirty entries, so they share one context
+    if (Entries[Index].IsDirty) { Recompute(); }
+
+    return Entries[Index].Result;
+}
+
+void FBlueprintDependencyEvaluation::BindChangeHooks()
+{
+    PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddSP(
+    this,
+    &FBlueprintDependencyEvaluation::OnObjectPropertyChanged);
+
+    // Adding, removing or reparenting components in the SCS editor marks the blueprint as structurally
+    // modified, which broadcasts OnChanged. Parent blueprints count as well, their components are inherited.
+    for (UClass* curClass{ BlueprintGC.Get() }; curClass; curClass = curClass->GetSuperClass())
+    {
+        UBlueprint* blueprint{ Cast<UBlueprint>(curClass->ClassGeneratedBy) };
+        if (!blueprint) { continue; }
+
+        ObservedBlueprints.Add({
+            blueprint,
+            blueprint->OnChanged().AddSP(this, &FBlueprintDependencyEvaluation::OnBlueprintChanged),
+            blueprint->OnCompiled().AddSP(this, &FBlueprintDependencyEvaluation::OnBlueprintChanged),
+        });
+    }
+}
+
+void FBlueprintDependencyEvaluation::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+    if (Event.GetMemberPropertyName() != GET_MEMBER_NAME_CHECKED(UActorComponent, ComponentTags)) { return; }
+
+    // Only component templates in this blueprint's hierarchy can affect its results
+    const UActorComponent* component{ Cast<UActorComponent>(Object) };
+    if (!component || !component->IsTemplate()) { return; }
+
+    const UBlueprintGeneratedClass* owningClass{ FDependencyUtils::GetOwningBlueprintClass(component) };
+    const UBlueprintGeneratedClass* blueprintGC{ BlueprintGC.Get() };
+    if (!owningClass || !blueprintGC || !blueprintGC->IsChildOf(owningClass)) { return; }
+
+    Invalidate(true);
+}
+
+void FBlueprintDependencyEvaluation::OnBlueprintChanged(UBlueprint* Blueprint)
+{
+    Invalidate(false);
+}
+
+void FBlueprintDependencyEvaluation::Invalidate(bool TagsOnly)
+{
+    // Tag edits don't change which components or nodes exist, so the context stays valid;
+    // only its gameplay tag containers need rebuilding
+    if (!TagsOnly) { Context.Reset(); }
+    else if (Context.IsSet()) { FDependencyUtils::UpdateGameplayTags(Context.GetValue()); }
+
+    for (FEntry& entry : Entries)
+    {
+        if (TagsOnly && !FDependencyUtils::IsTagDependency(entry.Dependency)) { continue; }
+        entry.IsDirty = true;
+    }
+}
+
+void FBlueprintDependencyEvaluation::Recompute()
+{
+    UBlueprintGeneratedClass* blueprintGC{ BlueprintGC.Get() };
+    if (!Context.IsSet() && blueprintGC)
+    {
+        Context = FDependencyUtils::MakeEvaluationContext(blueprintGC);
+    }
+
+    for (FEntry& entry : Entries)
+    {
+        if (!entry.IsDirty) { continue; }
+        entry.IsDirty = false;
+
+        const UActorComponent* component{ entry.Component.Get() };
+        if (!component || !blueprintGC || FDependencyUtils::GetOwningBlueprintClass(component) != blueprintGC)
+        {
+            entry.Result = { false, true, "Component no longer exists" };
+            continue;
+        }
+
+        entry.Result = FDependencyUtils::CheckDependency(Context.GetValue(), component, entry.Dependency);
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FDependencyUtils.h"
+
+/*
+ * A live evaluation of component dependencies inside a single blueprint.
+ * All entries are evaluated as one batch sharing a single FDependencyEvaluationContext, and only
+ * entries affected by an edit are recomputed: changing ComponentTags dirties tag based dependencies,
+ * SCS changes (adding, removing, reparenting components) or recompiles dirty everything.
+ * Recomputation is lazy and happens on the next GetResult call, so UI can bind directly to it.
+ */
+class FBlueprintDependencyEvaluation final : public TSharedFromThis<FBlueprintDependencyEvaluation>
+{
+public:
+    static TSharedRef<FBlueprintDependencyEvaluation> Create(UBlueprintGeneratedClass* BlueprintGC);
+    ~FBlueprintDependencyEvaluation();
+
+    // SourceComponent must be owned by this evaluation's blueprint. Returns the entry index.
+    int32 AddDependency(const UActorComponent* SourceComponent, const FComponentDependency& Dependency);
+    const FDependencyFulfilledResult& GetResult(int32 Index);
+
+private:
+    struct FEntry
+    {
+        TWeakObjectPtr<const UActorComponent> Component{};
+        FComponentDependency Dependency{};
+        FDependencyFulfilledResult Result{};
+        bool IsDirty{ true };
+    };
+
+    void BindChangeHooks();
+    void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+    void OnBlueprintChanged(UBlueprint* Blueprint);
+
+    void Invalidate(bool TagsOnly);
+    void Recompute();
+
+    TWeakObjectPtr<UBlueprintGeneratedClass> BlueprintGC{};
+    TArray<FEntry> Entries{};
+    // Reset whenever the blueprint structure changes; its pointers are only valid until then
+    TOptional<FDependencyEvaluationContext> Context{};
+
+    FDelegateHandle PropertyChangedHandle{};
+    struct FObservedBlueprint
+    {
+        TWeakObjectPtr<UBlueprint> Blueprint{};
+        FDelegateHandle ChangedHandle{};
+        FDelegateHandle CompiledHandle{};
+    };
+    TArray<FObservedBlueprint> ObservedBlueprints{};
+};
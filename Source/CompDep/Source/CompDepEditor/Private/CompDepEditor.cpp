@@ -1,9 +1,15 @@
 #include "CompDepEditor.h"
 
+#include "BlueprintDependencyEvaluation.h"
+#include "CompDepSettings.h"
+#include "DependencyCompilerExtension.h"
 #include "DependencyDetailCustomization.h"
+#include "DependencyDifferentialHarness.h"
+#include "DependencyManifestBuilder.h"
 #include "Editor.h"
 #include "EditorUtilitySubsystem.h"
 #include "EditorUtilityWidgetBlueprint.h"
+#include "ISettingsModule.h"
 #include "CompDep/Public/ComponentDependencies.h"
 
 #define LOCTEXT_NAMESPACE "Details"
@@ -13,11 +19,16 @@ void FCompDepEditorModule::StartupModule()
     FDependencyDetailCustomization::RegisterCustomizations();
     InitializeMenu();
     InitializeReloadHooks();
+    RegisterEvaluationEngines();
+    FDependencyManifestBuilder::RegisterCookHook();
+    UDependencyCompilerExtension::Register();
 }
 
 void FCompDepEditorModule::ShutdownModule()
 {
     FDependencyDetailCustomization::UnregisterCustomizations();
+    UnregisterEvaluationEngines();
+    FDependencyManifestBuilder::UnregisterCookHook();
 
     if (GEditor)
     {
@@ -69,6 +80,13 @@ void FCompDepEditorModule::PopulateSubMenu(UToolMenu* Menu)
     FText::FromString(""),
     FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Fullscreen"),
     FExecuteAction::CreateRaw(this, &FCompDepEditorModule::OpenDependencyViewer));
+
+    section.AddMenuEntry(
+    "dependency_viewer_scope",
+    FText::FromString("Dependency Viewer Scope..."),
+    FText::FromString("Limit the dependency viewer to folders, collections, a native parent class or open blueprints"),
+    FSlateIcon(FAppStyle::GetAppStyleSetName(), "Icons.Filter"),
+    FExecuteAction::CreateRaw(this, &FCompDepEditorModule::OpenViewerScopeSettings));
 }
 
 void FCompDepEditorModule::OpenDependencyViewer()
@@ -91,6 +109,15 @@ void FCompDepEditorModule::OpenDependencyViewer()
     editorUtility->SpawnAndRegisterTab(widgetClass);
 }
 
+void FCompDepEditorModule::OpenViewerScopeSettings()
+{
+    const UCompDepSettings* settings{ GetDefault<UCompDepSettings>() };
+    FModuleManager::LoadModuleChecked<ISettingsModule>("Settings").ShowViewer(
+    settings->GetContainerName(),
+    settings->GetCategoryName(),
+    settings->GetSectionName());
+}
+
 void FCompDepEditorModule::InitializeReloadHooks()
 {
     // This only works because our loading phase is PostEngineInit; otherwise GEditor would be null
@@ -113,6 +140,140 @@ void FCompDepEditorModule::InitializeReloadHooks()
     }
 }
 
+void FCompDepEditorModule::RegisterEvaluationEngines()
+{
+    // Every alternative evaluation path gets registered here, so the differential harness keeps it honest
+    FDependencyDifferentialHarness::RegisterEngine("Batched", []() -> FDependencyEvaluationEngine
+    {
+        return [](TConstArrayView<FDependencyHarnessQuery> Queries)
+        {
+            FDependencyEvaluationBatch batch{};
+            TArray<FDependencyFulfilledResult> results{};
+
+            for (const FDependencyHarnessQuery& query : Queries)
+            {
+                results.Add(batch.CheckDependency(query.Component, query.Dependency));
+            }
+
+            return results;
+        };
+    });
+
+    // One cache per harness run, like one per scan: structurally identical blueprints from different
+    // cases share results, so any signature that's missing an input shows up as a divergence
+    FDependencyDifferentialHarness::RegisterEngine("Memoized", []() -> FDependencyEvaluationEngine
+    {
+        TSharedRef<FDependencyResultCache> cache{ MakeShared<FDependencyResultCache>() };
+        return [cache](TConstArrayView<FDependencyHarnessQuery> Queries)
+        {
+            FDependencyEvaluationBatch batch{ &cache.Get() };
+            TArray<FDependencyFulfilledResult> results{};
+
+            for (const FDependencyHarnessQuery& query : Queries)
+            {
+                results.Add(batch.CheckDependency(query.Component, query.Dependency));
+            }
+
+            return results;
+        };
+    });
+
+    // The details panel path: one live evaluation per owning blueprint, read once, then driven through a
+    // ComponentTags edit and its revert. Only the tag-only invalidation runs in between, so anything it
+    // fails to dirty (or refresh in the context) leaves stale results behind that diverge from the reference.
+    FDependencyDifferentialHarness::RegisterEngine("Live", []() -> FDependencyEvaluationEngine
+    {
+        return [](TConstArrayView<FDependencyHarnessQuery> Queries)
+        {
+            TMap<UBlueprintGeneratedClass*, TSharedRef<FBlueprintDependencyEvaluation>> evaluations{};
+            TArray<TPair<FBlueprintDependencyEvaluation*, int32>> entries{};
+
+            for (const FDependencyHarnessQuery& query : Queries)
+            {
+                UBlueprintGeneratedClass* owningClass{ FDependencyUtils::GetOwningBlueprintClass(query.Component) };
+                if (!evaluations.Contains(owningClass)) { evaluations.Add(owningClass, FBlueprintDependencyEvaluation::Create(owningClass)); }
+
+                FBlueprintDependencyEvaluation& evaluation{ evaluations[owningClass].Get() };
+                entries.Emplace(&evaluation, evaluation.AddDependency(query.Component, query.Dependency));
+            }
+
+            auto readAll{ [&entries]()
+            {
+                TArray<FDependencyFulfilledResult> results{};
+                for (const auto& [evaluation, index] : entries)
+                {
+                    results.Add(evaluation->GetResult(index));
+                }
+                return results;
+            } };
+
+            readAll();
+
+            // Any source component works; the evaluations of blueprints deriving from its owner are affected too
+            if (!Queries.IsEmpty())
+            {
+                UActorComponent* edited{ const_cast<UActorComponent*>(Queries[0].Component) };
+                FProperty* tagsProperty{ FindFProperty<FProperty>(UActorComponent::StaticClass(), GET_MEMBER_NAME_CHECKED(UActorComponent, ComponentTags)) };
+                FPropertyChangedEvent tagsChanged{ tagsProperty };
+
+                const TArray<FName> originalTags{ edited->ComponentTags };
+                if (originalTags.IsEmpty()) { edited->ComponentTags.Add(TEXT("CompDep.Harness.Weapon")); }
+                else { edited->ComponentTags.Reset(); }
+                FCoreUObjectDelegates::OnObjectPropertyChanged.Broadcast(edited, tagsChanged);
+                readAll();
+
+                edited->ComponentTags = originalTags;
+                FCoreUObjectDelegates::OnObjectPropertyChanged.Broadcast(edited, tagsChanged);
+            }
+
+            return readAll();
+        };
+    });
+
+    // The compile diagnostics path, run on fully compiled blueprints: SCS templates with their overrides, and
+    // native components from the parent CDO. Sources are matched by name, since the context holds the parent's
+    // copies of native components rather than the ones on the blueprint's own CDO.
+    FDependencyDifferentialHarness::RegisterEngine("Compilation", []() -> FDependencyEvaluationEngine
+    {
+        return [](TConstArrayView<FDependencyHarnessQuery> Queries)
+        {
+            TMap<UBlueprintGeneratedClass*, FDependencyEvaluationContext> contexts{};
+            TArray<FDependencyFulfilledResult> results{};
+
+            for (const FDependencyHarnessQuery& query : Queries)
+            {
+                UBlueprintGeneratedClass* owningClass{ FDependencyUtils::GetOwningBlueprintClass(query.Component) };
+                if (!owningClass)
+                {
+                    results.Add(FDependencyUtils::CheckDependency(query.Component, query.Dependency));
+                    continue;
+                }
+
+                if (!contexts.Contains(owningClass)) { contexts.Add(owningClass, FDependencyUtils::MakeCompilationContext(owningClass)); }
+                const FDependencyEvaluationContext& context{ contexts[owningClass] };
+
+                const UActorComponent* source{ query.Component };
+                for (const UActorComponent* component : context.Components)
+                {
+                    if (component->GetFName() == query.Component->GetFName()) { source = component; break; }
+                }
+
+                results.Add(FDependencyUtils::CheckDependency(context, source, query.Dependency));
+            }
+
+            return results;
+        };
+    });
+}
+
+void FCompDepEditorModule::UnregisterEvaluationEngines()
+{
+    FDependencyDifferentialHarness::UnregisterEngine("Batched");
+    FDependencyDifferentialHarness::UnregisterEngine("Memoized");
+    FDependencyDifferentialHarness::UnregisterEngine("Live");
+    FDependencyDifferentialHarness::UnregisterEngine("Compilation");
+}
+
 #undef LOCTEXT_NAMESPACE
 
 IMPLEMENT_MODULE(FCompDepEditorModule, CompDepEditor)
@@ -0,0 +1,8 @@
+#include "CompDepManifestCommandlet.h"
+
+#include "DependencyManifestBuilder.h"
+
+int32 UCompDepManifestCommandlet::Main(const FString& Params)
+{
+    return FDependencyManifestBuilder::BuildAndSave() ? 0 : 1;
+}
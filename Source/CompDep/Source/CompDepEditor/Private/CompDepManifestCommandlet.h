@@ -0,0 +1,15 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CompDepManifestCommandlet.generated.h"
+
+// Writes the component dependency manifest; usage: UnrealEditor-Cmd <Project> -run=CompDepManifest
+UCLASS()
+class UCompDepManifestCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    virtual int32 Main(const FString& Params) override;
+};
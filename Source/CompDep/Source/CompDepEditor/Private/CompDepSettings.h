@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DependencyScanner.h"
+#include "Engine/DeveloperSettings.h"
+#include "CompDepSettings.generated.h"
+
+UCLASS(config = EditorPerProjectUserSettings, meta = (DisplayName = "Component Dependencies"))
+class UCompDepSettings : public UDeveloperSettings
+{
+    GENERATED_BODY()
+
+public:
+    virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
+
+    // Amount of blueprint packages loaded and evaluated before checking the memory budget in low-memory scans
+    UPROPERTY(Config, EditAnywhere, Category = "Scanning", meta = (ClampMin = 1))
+    int32 ScanBatchSize{ 64 };
+
+    // Once used physical memory grew by more than this since the scan started, blueprints the scan loaded are released
+    UPROPERTY(Config, EditAnywhere, Category = "Scanning", meta = (ClampMin = 64, Units = "Megabytes"))
+    int32 ScanMemoryBudgetMB{ 1024 };
+
+    // Limits which blueprints the dependency viewer queries; an empty scope covers the whole project
+    UPROPERTY(Config, EditAnywhere, Category = "Viewer")
+    FDependencyQueryScope ViewerScope{};
+
+    // Let the viewer scan in batches like QueryBlueprintsLowMemory; only blueprints that end up in its results are loaded again
+    UPROPERTY(Config, EditAnywhere, Category = "Viewer")
+    bool ViewerLowMemoryQueries{ false };
+
+    // Also report components whose dependencies' own required dependencies are missing, and requirement cycles
+    UPROPERTY(Config, EditAnywhere, Category = "Evaluation")
+    bool EnableTransitiveChecks{ false };
+
+    // Report missing required dependencies as warnings in the Blueprint compiler results
+    UPROPERTY(Config, EditAnywhere, Category = "Evaluation")
+    bool EnableCompileDiagnostics{ true };
+
+    // Re-check blueprints that are opened, edited or affected by a compile in the background, reporting new problems to the CompDep message log
+    UPROPERTY(Config, EditAnywhere, Category = "Background Validation")
+    bool EnableBackgroundValidation{ true };
+
+    // Time background validation may spend per editor frame
+    UPROPERTY(Config, EditAnywhere, Category = "Background Validation", meta = (ClampMin = 0.1, Units = "Milliseconds", EditCondition = "EnableBackgroundValidation"))
+    float BackgroundValidationBudgetMs{ 2.f };
+
+    // Background validation only runs after the user hasn't interacted with the editor for this long
+    UPROPERTY(Config, EditAnywhere, Category = "Background Validation", meta = (ClampMin = 0, Units = "Seconds", EditCondition = "EnableBackgroundValidation"))
+    float BackgroundValidationIdleDelay{ 0.5f };
+};
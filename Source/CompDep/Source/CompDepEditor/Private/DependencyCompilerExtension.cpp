@@ -0,0 +1,51 @@
+#include "DependencyCompilerExtension.h"
+
+#include "BlueprintCompilationManager.h"
+#include "CompDepSettings.h"
+#include "FDependencyUtils.h"
+#include "KismetCompiler.h"
+#include "CompDep/Public/ComponentDependencies.h"
+#include "Engine/BlueprintGeneratedClass.h"
+
+void UDependencyCompilerExtension::Register()
+{
+    // The compilation manager has no way to unregister extensions, so this one lives as long as the editor
+    UDependencyCompilerExtension* extension{ NewObject<UDependencyCompilerExtension>() };
+    extension->AddToRoot();
+    FBlueprintCompilationManager::RegisterCompilerExtension(UBlueprint::StaticClass(), extension);
+}
+
+void UDependencyCompilerExtension::ProcessBlueprintCompiled(const FKismetCompilerContext& CompilationContext, const FBlueprintCompiledData& Data)
+{
+    if (!GetDefault<UCompDepSettings>()->EnableCompileDiagnostics) { return; }
+
+    UBlueprintGeneratedClass* blueprintGC{ Cast<UBlueprintGeneratedClass>(CompilationContext.NewClass) };
+    if (!blueprintGC || !blueprintGC->IsChildOf(AActor::StaticClass())) { return; }
+
+    // The class is only partially set up at this point, so the context is built from the compiled SCS
+    // instead of walking the class's (possibly stale) CDO
+    const FDependencyEvaluationContext context{ FDependencyUtils::MakeCompilationContext(blueprintGC) };
+    for (const UActorComponent* component : context.Components)
+    {
+        if (!component->GetClass()->ImplementsInterface(UComponentDependencies::StaticClass())) { continue; }
+        if (FDependencyUtils::GetOwningBlueprintClass(component) != blueprintGC) { continue; }
+
+        const TArray<FComponentDependency> dependencies{ IComponentDependencies::Execute_GetDependencies(component) };
+        for (const FComponentDependency& dependency : dependencies)
+        {
+            if (dependency.Type == EComponentDependencyType::Optional) { continue; }
+
+            const FDependencyFulfilledResult result{ FDependencyUtils::CheckDependency(context, component, dependency) };
+            if (result.IsFulfilled || !result.ShowDependency) { continue; }
+
+            // The message log is held by reference, so it can be written through the const context
+            CompilationContext.MessageLog.Warning(
+            *FString::Printf(
+            TEXT("@@: %s on %s: %s"),
+            *FDependencyUtils::GetDependencyDescriptionText(dependency).ToString(),
+            dependency.HasClass() ? *dependency.GetClassName() : TEXT("<none>"),
+            *result.OutputString),
+            component);
+        }
+    }
+}
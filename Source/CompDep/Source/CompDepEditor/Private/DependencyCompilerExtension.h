@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintCompilerExtension.h"
+#include "DependencyCompilerExtension.generated.h"
+
+/*
+ * Reports missing required dependencies as warnings in the Blueprint compiler results as soon as a
+ * blueprint compiles. Every dependency of the compiled class's own components is checked against one
+ * evaluation context built from the compiled SCS templates, instead of walking the blueprint per dependency.
+ * Inherited components are reported when the blueprint that adds them compiles.
+ */
+UCLASS()
+class UDependencyCompilerExtension : public UBlueprintCompilerExtension
+{
+    GENERATED_BODY()
+
+public:
+    static void Register();
+
+protected:
+    virtual void ProcessBlueprintCompiled(const FKismetCompilerContext& CompilationContext, const FBlueprintCompiledData& Data) override;
+};
@@ -1,5 +1,6 @@
 ﻿#include "DependencyDetailCustomization.h"
 
+#include "BlueprintDependencyEvaluation.h"
 #include "DetailCategoryBuilder.h"
 #include "DetailLayoutBuilder.h"
 #include "DetailWidgetRow.h"
@@ -72,31 +73,67 @@ void FDependencyDetailCustomization::CustomizeDetails(IDetailLayoutBuilder& Deta
     TArray<TWeakObjectPtr<>> selectedList;
     DetailLayout.GetObjectsBeingCustomized(selectedList);
 
-    // Disallow multi-select in editor while viewing dependencies
-    if (selectedList.Num() != 1) { return; }
+    struct FDependencyRow
+    {
+        const UActorComponent* Component{};
+        FComponentDependency Dependency{};
+        TSharedPtr<FBlueprintDependencyEvaluation> Evaluation{};
+        int32 EvaluationIndex{ INDEX_NONE };
+    };
+
+    // All selected components of the same blueprint share one evaluation, so they're evaluated in one batch
+    TMap<UBlueprintGeneratedClass*, TSharedRef<FBlueprintDependencyEvaluation>> evaluations{};
+    TArray<FDependencyRow> rows{};
+    int32 selectedCompCount{};
+
+    for (const TWeakObjectPtr<>& selected : selectedList)
+    {
+        const UObject* selectedObj{ selected.Get() };
+        if (!selectedObj) { continue; }
+
+        // Only operate on CDO (Blueprint, etc.)
+        if (!selectedObj->IsTemplate()) { continue; }
 
-    const UObject* selectedObj{ selectedList[0].Get() };
-    check(selectedObj);
+        const UActorComponent* selectedComp{ Cast<UActorComponent>(selectedObj) };
+        // It's assumed this will always be on a component as a detail customization
+        check(selectedComp);
 
-    // Only operate on CDO (Blueprint, etc.)
-    if (!selectedObj->IsTemplate()) { return; }
+        check(selectedComp->GetClass()->ImplementsInterface(UComponentDependencies::StaticClass()));
 
-    const UActorComponent* selectedComp{ Cast<UActorComponent>(selectedObj) };
-    // It's assumed this will always be on a component as a detail customization
-    check(selectedComp);
+        if (selectedComp->GetClass() != RegisteredCustomizationClass) { continue; }
 
-    check(selectedComp->GetClass()->ImplementsInterface(UComponentDependencies::StaticClass()));
+        // Without an owning blueprint, every dependency would be hidden anyway
+        UBlueprintGeneratedClass* blueprintGC{ FDependencyUtils::GetOwningBlueprintClass(selectedComp) };
+        if (!blueprintGC) { continue; }
 
-    if (selectedComp->GetClass() != RegisteredCustomizationClass) { return; }
+        if (!evaluations.Contains(blueprintGC))
+        {
+            evaluations.Add(blueprintGC, FBlueprintDependencyEvaluation::Create(blueprintGC));
+        }
+        const TSharedRef<FBlueprintDependencyEvaluation>& evaluation{ evaluations.FindChecked(blueprintGC) };
 
-    // These are the dependencies actually defined in the C++ class or Blueprint implementation
-    TArray<FComponentDependency> dependencies{ IComponentDependencies::Execute_GetDependencies(selectedComp) };
+        ++selectedCompCount;
+
+        // These are the dependencies actually defined in the C++ class or Blueprint implementation
+        TArray<FComponentDependency> dependencies{ IComponentDependencies::Execute_GetDependencies(selectedComp) };
+        for (const FComponentDependency& dependency : dependencies)
+        {
+            if (!dependency.HasClass()) { continue; }
+
+            rows.Add({ selectedComp, dependency, evaluation, evaluation->AddDependency(selectedComp, dependency) });
+        }
+    }
+
+    if (rows.IsEmpty()) { return; }
 
     IDetailCategoryBuilder& category{ DetailLayout.EditCategory(
     TEXT("Dependencies"),
     FText::GetEmpty(),
     ECategoryPriority::Important) };
 
+    FSlateFontInfo componentNameFont{ IDetailLayoutBuilder::GetDetailFontBold() };
+    componentNameFont.Size = 10;
+
     FSlateFontInfo dependencyTextFont{ IDetailLayoutBuilder::GetDetailFontBold() };
     dependencyTextFont.Size = 7;
 
@@ -106,19 +143,30 @@ void FDependencyDetailCustomization::CustomizeDetails(IDetailLayoutBuilder& Deta
     FSlateFontInfo resultTextFont{ IDetailLayoutBuilder::GetDetailFontBold() };
     resultTextFont.Size = 8;
 
-    for (const FComponentDependency& dependency : dependencies)
+    const UActorComponent* lastComp{};
+    for (const FDependencyRow& row : rows)
     {
-        if (dependency.Class == nullptr) { continue; }
+        // Whether a dependency is shown only depends on the viewing context, so it's decided once here;
+        // the first query evaluates the whole batch.
+        if (!row.Evaluation->GetResult(row.EvaluationIndex).ShowDependency) { continue; }
 
-        // Calc whether this dependency is fulfilled; if we're viewing in the wrong context, hide it
-        FDependencyFulfilledResult result{ FDependencyUtils::CheckDependency(selectedComp, dependency) };
-        if (!result.ShowDependency) { continue; }
+        // With multiple components selected, group their dependencies under their names
+        if (selectedCompCount > 1 && row.Component != lastComp)
+        {
+            const FString componentName{ row.Component->GetName() };
+            category.AddCustomRow(FText::FromString(componentName))
+            [SNew(STextBlock)
+             .Text(FText::FromString(componentName))
+             .Font(componentNameFont)];
+        }
+        lastComp = row.Component;
 
-        // Get color based on result
-        const bool isOptional{ dependency.Type == EComponentDependencyType::Optional };
-        FSlateColor textColor{ (result.IsFulfilled || isOptional) ? FStyleColors::Success : FStyleColors::Error };
+        const bool isOptional{ row.Dependency.Type == EComponentDependencyType::Optional };
+        const FString className{ row.Dependency.GetClassName() };
 
-        const FString className{ dependency.Class->GetName() };
+        // Result text and color stay bound to the evaluation, so they follow SCS and tag edits
+        TSharedRef<FBlueprintDependencyEvaluation> evaluation{ row.Evaluation.ToSharedRef() };
+        const int32 index{ row.EvaluationIndex };
 
         category.AddCustomRow(FText::FromString(className))
         [SNew(SBox)
@@ -129,7 +177,7 @@ void FDependencyDetailCustomization::CustomizeDetails(IDetailLayoutBuilder& Deta
            + SVerticalBox::Slot()
              .HAlign(HAlign_Center)
              [SNew(STextBlock)
-              .Text(FDependencyUtils::GetDependencyDescriptionText(dependency))
+              .Text(FDependencyUtils::GetDependencyDescriptionText(row.Dependency))
               .Font(dependencyTextFont)
               .AutoWrapText(true)]
            + SVerticalBox::Slot()
@@ -142,8 +190,16 @@ void FDependencyDetailCustomization::CustomizeDetails(IDetailLayoutBuilder& Deta
             .HAlign(HAlign_Center)
             .VAlign(VAlign_Center)
             [SNew(STextBlock)
-             .Text(FText::FromString(result.OutputString))
-             .ColorAndOpacity(textColor)
+             .Text_Lambda([evaluation, index]
+             {
+                 return FText::FromString(evaluation->GetResult(index).OutputString);
+             })
+             .ColorAndOpacity_Lambda([evaluation, index, isOptional]() -> FSlateColor
+             {
+                 // Get color based on result
+                 const bool isFulfilled{ evaluation->GetResult(index).IsFulfilled };
+                 return (isFulfilled || isOptional) ? FStyleColors::Success : FStyleColors::Error;
+             })
              .Margin(FMargin(15, 0))
              .AutoWrapText(true)
              .Font(resultTextFont)]]];
@@ -0,0 +1,591 @@
+#include "DependencyDifferentialHarness.h"
+
+#include "DependencyScanner.h"
+#include "Components/ArrowComponent.h"
+#include "Components/AudioComponent.h"
+#include "Components/BoxComponent.h"
+#include "Components/SphereComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/InheritableComponentHandler.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "GameFramework/RotatingMovementComponent.h"
+#include "GameplayTagsManager.h"
+#include "Kismet2/KismetEditorUtilities.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCompDepHarness, Log, All);
+
+TMap<FName, FDependencyEvaluationEngineFactory> FDependencyDifferentialHarness::EngineFactories{};
+TArray<TWeakObjectPtr<UBlueprint>> FDependencyDifferentialHarness::CreatedBlueprints{};
+
+namespace
+{
+    constexpr int32 MaxNodesPerCase{ 8 };
+    constexpr int32 QueriesPerComponent{ 4 };
+
+    // Added as transient editor tags when the harness runs, so tag queries have something to match without
+    // writing tags into any project's config. Rifle sits under Weapon to exercise hierarchical matching.
+    const TCHAR* const HarnessTagNames[]{
+        TEXT("CompDep.Harness.Weapon"),
+        TEXT("CompDep.Harness.Weapon.Rifle"),
+        TEXT("CompDep.Harness.Armor"),
+    };
+
+    const TArray<FName>& GetTagPool()
+    {
+        static const TArray<FName> tags{
+            TEXT("tag_a"),
+            TEXT("tag_b"),
+            TEXT("tag_c"),
+            HarnessTagNames[0],
+            HarnessTagNames[1],
+            HarnessTagNames[2],
+        };
+        return tags;
+    }
+
+    FGameplayTagQuery GenerateTagQuery(FRandomStream& Random)
+    {
+        if (Random.FRand() < 0.1f) { return {}; }
+
+        auto randomTag{ [&Random]()
+        {
+            return FGameplayTag::RequestGameplayTag(HarnessTagNames[Random.RandHelper(static_cast<int32>(UE_ARRAY_COUNT(HarnessTagNames)))]);
+        } };
+
+        FGameplayTagContainer queryTags{ randomTag() };
+        if (Random.FRand() < 0.3f) { queryTags.AddTag(randomTag()); }
+
+        switch (Random.RandHelper(3))
+        {
+        case 0: return FGameplayTagQuery::MakeQuery_MatchAnyTags(queryTags);
+        case 1: return FGameplayTagQuery::MakeQuery_MatchAllTags(queryTags);
+        default: return FGameplayTagQuery::MakeQuery_MatchNoTags(queryTags);
+        }
+    }
+}
+
+void FDependencyDifferentialHarness::RegisterEngine(FName Name, FDependencyEvaluationEngineFactory Factory)
+{
+    EngineFactories.Add(Name, MoveTemp(Factory));
+}
+
+void FDependencyDifferentialHarness::UnregisterEngine(FName Name)
+{
+    EngineFactories.Remove(Name);
+}
+
+int32 FDependencyDifferentialHarness::Run(int32 Iterations, int32 Seed)
+{
+    if (EngineFactories.IsEmpty())
+    {
+        UE_LOG(LogCompDepHarness, Warning, TEXT("No alternative evaluation engines registered; nothing to compare against."));
+        return 0;
+    }
+
+    // Transient tags are gone after a restart; only add missing ones, since every addition rebuilds the tag tree
+    UGameplayTagsManager& tagsManager{ UGameplayTagsManager::Get() };
+    for (const TCHAR* tagName : HarnessTagNames)
+    {
+        if (!tagsManager.RequestGameplayTag(tagName, false).IsValid()) { tagsManager.AddTransientEditorGameplayTag(tagName); }
+    }
+
+    TMap<FName, FDependencyEvaluationEngine> engines{};
+    for (const auto& [engineName, factory] : EngineFactories)
+    {
+        engines.Add(engineName, factory());
+    }
+
+    FRandomStream random{ Seed };
+    int32 divergenceCount{};
+    // Generated blueprints are compiled and dirtied constantly; keep background validation out of it
+    const FDependencyScanner::FScanScope scanScope{};
+
+    for (int32 iteration{}; iteration < Iterations; ++iteration)
+    {
+        const FCaseSpec testCase{ GenerateCase(random) };
+        const FBuiltCase built{ BuildCase(testCase) };
+        if (!built.BlueprintGC) { continue; }
+
+        TArray<FDependencyHarnessQuery> queries{};
+        for (const UActorComponent* component : built.Components)
+        {
+            for (int32 i{}; i < QueriesPerComponent; ++i)
+            {
+                queries.Add({ component, GenerateDependency(random) });
+            }
+        }
+
+        TArray<FDependencyFulfilledResult> expected{};
+        for (const FDependencyHarnessQuery& query : queries)
+        {
+            expected.Add(FDependencyUtils::CheckDependency(query.Component, query.Dependency));
+        }
+
+        for (const auto& [engineName, engine] : engines)
+        {
+            const TArray<FDependencyFulfilledResult> actual{ engine(queries) };
+
+            for (int32 i{}; i < queries.Num(); ++i)
+            {
+                if (actual.IsValidIndex(i) && IsSameResult(expected[i], actual[i])) { continue; }
+
+                ++divergenceCount;
+
+                // Shrink with a single query; the remaining queries of this case would most likely
+                // shrink down to the same minimal case, so only report the first one per engine.
+                FCaseSpec minimalCase{ testCase };
+                const FName sourceName{ queries[i].Component->GetFName() };
+                FComponentDependency minimalDependency{ queries[i].Dependency };
+                Shrink(minimalCase, sourceName, minimalDependency, engine);
+
+                UE_LOG(
+                LogCompDepHarness,
+                Error,
+                TEXT("Engine '%s' diverged from the reference (iteration %d, seed %d).\nExpected: '%s'\nActual: '%s'\nMinimal case:\n%s"),
+                *engineName.ToString(),
+                iteration,
+                Seed,
+                *expected[i].OutputString,
+                actual.IsValidIndex(i) ? *actual[i].OutputString : TEXT("<missing result>"),
+                *DescribeCase(minimalCase, sourceName, minimalDependency));
+                break;
+            }
+        }
+    }
+
+    UE_LOG(
+    LogCompDepHarness,
+    Display,
+    TEXT("Differential harness finished: %d iterations, %d engine(s), %d divergence(s)."),
+    Iterations,
+    engines.Num(),
+    divergenceCount);
+
+    ReleaseBlueprints();
+
+    return divergenceCount;
+}
+
+FDependencyDifferentialHarness::FCaseSpec FDependencyDifferentialHarness::GenerateCase(FRandomStream& Random)
+{
+    const TArray<UClass*> sceneClasses{
+        USceneComponent::StaticClass(),
+        UStaticMeshComponent::StaticClass(),
+        USphereComponent::StaticClass(),
+        UBoxComponent::StaticClass(),
+        UArrowComponent::StaticClass(),
+        UAudioComponent::StaticClass(),
+    };
+    const TArray<UClass*> actorClasses{
+        UProjectileMovementComponent::StaticClass(),
+        URotatingMovementComponent::StaticClass(),
+    };
+    const TArray<FName>& tagPool{ GetTagPool() };
+
+    FCaseSpec result{};
+    // ACharacter brings native components along, which exercises the CDO outer path
+    result.NativeParentClass = Random.FRand() < 0.3f ? ACharacter::StaticClass() : AActor::StaticClass();
+    result.UseChildBlueprint = Random.FRand() < 0.4f;
+
+    const int32 nodeCount{ Random.RandRange(1, MaxNodesPerCase) };
+    for (int32 i{}; i < nodeCount; ++i)
+    {
+        FNodeSpec node{};
+        node.Name = *FString::Printf(TEXT("Node_%d"), i);
+        node.InChildBlueprint = result.UseChildBlueprint && Random.FRand() < 0.5f;
+
+        const bool isScene{ Random.FRand() < 0.75f };
+        node.Class = isScene
+                         ? sceneClasses[Random.RandHelper(sceneClasses.Num())]
+                         : actorClasses[Random.RandHelper(actorClasses.Num())];
+
+        // Only SceneComponents can be attached to each other
+        if (isScene)
+        {
+            TArray<int32> parentCandidates{};
+            for (int32 j{}; j < i; ++j)
+            {
+                const FNodeSpec& other{ result.Nodes[j] };
+                if (!other.Class->IsChildOf(USceneComponent::StaticClass())) { continue; }
+                // Parent blueprint nodes can't see child blueprint nodes; the other way around attaches to the inherited node
+                if (other.InChildBlueprint && !node.InChildBlueprint) { continue; }
+                parentCandidates.Add(j);
+            }
+
+            if (!parentCandidates.IsEmpty() && Random.FRand() < 0.7f)
+            {
+                node.Parent = parentCandidates[Random.RandHelper(parentCandidates.Num())];
+            }
+        }
+
+        const int32 tagCount{ Random.RandRange(0, 2) };
+        for (int32 t{}; t < tagCount; ++t)
+        {
+            node.Tags.AddUnique(tagPool[Random.RandHelper(tagPool.Num())]);
+        }
+
+        if (result.UseChildBlueprint && !node.InChildBlueprint && Random.FRand() < 0.3f)
+        {
+            node.OverriddenInChild = true;
+            const int32 overrideTagCount{ Random.RandRange(0, 2) };
+            for (int32 t{}; t < overrideTagCount; ++t)
+            {
+                node.OverrideTags.AddUnique(tagPool[Random.RandHelper(tagPool.Num())]);
+            }
+        }
+
+        result.Nodes.Add(MoveTemp(node));
+    }
+
+    return result;
+}
+
+FComponentDependency FDependencyDifferentialHarness::GenerateDependency(FRandomStream& Random)
+{
+    // Includes abstract bases, so IsA on parents gets exercised as well
+    const TArray<UClass*> dependencyClasses{
+        UActorComponent::StaticClass(),
+        USceneComponent::StaticClass(),
+        UPrimitiveComponent::StaticClass(),
+        UShapeComponent::StaticClass(),
+        UStaticMeshComponent::StaticClass(),
+        USphereComponent::StaticClass(),
+        UBoxComponent::StaticClass(),
+        UArrowComponent::StaticClass(),
+        UAudioComponent::StaticClass(),
+        UMovementComponent::StaticClass(),
+        UProjectileMovementComponent::StaticClass(),
+        URotatingMovementComponent::StaticClass(),
+    };
+    const TArray<FName>& tagPool{ GetTagPool() };
+
+    FComponentDependency result{};
+    result.Position = static_cast<EComponentDependencyPosition>(Random.RandHelper(6));
+    result.Class = Random.FRand() < 0.05f ? nullptr : dependencyClasses[Random.RandHelper(dependencyClasses.Num())];
+    result.Meta = Random.FRand() < 0.2f ? NAME_None : tagPool[Random.RandHelper(tagPool.Num())];
+    result.Type = Random.FRand() < 0.5f ? EComponentDependencyType::Required : EComponentDependencyType::Optional;
+    // Also set for other positions, which have to ignore it
+    result.TagQuery = GenerateTagQuery(Random);
+
+    // Same class, declared softly
+    if (result.Class && Random.FRand() < 0.2f)
+    {
+        result.SoftClass = TSoftClassPtr<UActorComponent>{ FSoftObjectPath{ result.Class.Get() } };
+        result.Class = nullptr;
+    }
+    // Soft classes that aren't loaded (and never will be) have to be matched by path alone
+    else if (Random.FRand() < 0.1f)
+    {
+        const TArray<FString> unloadedPaths{
+            TEXT("/Script/Engine.CompDepMissingComponent"),
+            TEXT("/Game/CompDepHarness/BP_MissingComponent.BP_MissingComponent_C"),
+        };
+        result.SoftClass = TSoftClassPtr<UActorComponent>{ FSoftObjectPath{ unloadedPaths[Random.RandHelper(unloadedPaths.Num())] } };
+        result.Class = nullptr;
+    }
+    return result;
+}
+
+FDependencyDifferentialHarness::FBuiltCase FDependencyDifferentialHarness::BuildCase(const FCaseSpec& Case)
+{
+    // Shared between both blueprints, so child blueprint nodes can find the inherited nodes they attach to
+    TMap<int32, USCS_Node*> createdNodes{};
+    auto addNodes{ [&Case, &createdNodes](const UBlueprint* Blueprint, bool ForChildBlueprint)
+    {
+        USimpleConstructionScript* scs{ Blueprint->SimpleConstructionScript };
+        check(scs);
+
+        for (int32 i{}; i < Case.Nodes.Num(); ++i)
+        {
+            const FNodeSpec& spec{ Case.Nodes[i] };
+            if (spec.InChildBlueprint != ForChildBlueprint) { continue; }
+
+            USCS_Node* node{ scs->CreateNode(spec.Class, spec.Name) };
+            node->ComponentTemplate->ComponentTags = spec.Tags;
+
+            USCS_Node* const* parentNode{ createdNodes.Find(spec.Parent) };
+            if (parentNode && Case.Nodes[spec.Parent].InChildBlueprint == ForChildBlueprint)
+            {
+                (*parentNode)->AddChildNode(node);
+            }
+            else
+            {
+                // A root node of this SCS; attached to the inherited node if its parent lives in the parent blueprint
+                if (parentNode) { node->SetParent(*parentNode); }
+                scs->AddNode(node);
+            }
+
+            createdNodes.Add(i, node);
+        }
+    } };
+
+    UBlueprint* blueprint{ CreateBlueprint(Case.NativeParentClass) };
+    if (!blueprint) { return {}; }
+    addNodes(blueprint, false);
+    FKismetEditorUtilities::CompileBlueprint(blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+
+    if (Case.UseChildBlueprint)
+    {
+        blueprint = CreateBlueprint(blueprint->GeneratedClass);
+        if (!blueprint) { return {}; }
+        addNodes(blueprint, true);
+
+        UInheritableComponentHandler* handler{ blueprint->GetInheritableComponentHandler(true) };
+        for (int32 i{}; i < Case.Nodes.Num(); ++i)
+        {
+            const FNodeSpec& spec{ Case.Nodes[i] };
+            if (!spec.OverriddenInChild || spec.InChildBlueprint || !handler) { continue; }
+
+            UActorComponent* overridden{ handler->CreateOverridenComponentTemplate(FComponentKey{ createdNodes[i] }) };
+            if (overridden) { overridden->ComponentTags = spec.OverrideTags; }
+        }
+
+        FKismetEditorUtilities::CompileBlueprint(blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+    }
+
+    FBuiltCase result{};
+    result.BlueprintGC = Cast<UBlueprintGeneratedClass>(blueprint->GeneratedClass);
+    result.Components = FDependencyUtils::GetAllBlueprintComponentsByName(result.BlueprintGC);
+    return result;
+}
+
+UBlueprint* FDependencyDifferentialHarness::CreateBlueprint(UClass* ParentClass)
+{
+    const FName name{ MakeUniqueObjectName(GetTransientPackage(), UBlueprint::StaticClass(), TEXT("CompDepHarnessBP")) };
+    UBlueprint* blueprint{ FKismetEditorUtilities::CreateBlueprint(
+    ParentClass,
+    GetTransientPackage(),
+    name,
+    BPTYPE_Normal,
+    UBlueprint::StaticClass(),
+    UBlueprintGeneratedClass::StaticClass()) };
+
+    CreatedBlueprints.Add(blueprint);
+    return blueprint;
+}
+
+void FDependencyDifferentialHarness::ReleaseBlueprints()
+{
+    // Blueprints are RF_Standalone, which keeps them alive through a regular GC even in the transient package
+    for (const TWeakObjectPtr<UBlueprint>& weakBlueprint : CreatedBlueprints)
+    {
+        UBlueprint* blueprint{ weakBlueprint.Get() };
+        if (!blueprint) { continue; }
+
+        for (UObject* object : TArray<UObject*>{ blueprint, blueprint->GeneratedClass.Get(), blueprint->SkeletonGeneratedClass.Get() })
+        {
+            if (!object) { continue; }
+
+            object->ClearFlags(RF_Standalone | RF_Public);
+            object->MarkAsGarbage();
+        }
+    }
+
+    CreatedBlueprints.Reset();
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+bool FDependencyDifferentialHarness::IsSameResult(const FDependencyFulfilledResult& A, const FDependencyFulfilledResult& B)
+{
+    return A.IsFulfilled == B.IsFulfilled
+        && A.ShowDependency == B.ShowDependency
+        && A.OutputString.Equals(B.OutputString, ESearchCase::CaseSensitive);
+}
+
+bool FDependencyDifferentialHarness::Diverges(
+const FCaseSpec& Case,
+FName SourceName,
+const FComponentDependency& Dependency,
+const FDependencyEvaluationEngine& Engine)
+{
+    const FBuiltCase built{ BuildCase(Case) };
+    if (!built.BlueprintGC) { return false; }
+
+    UActorComponent* const* source{ built.Components.FindByPredicate([SourceName](const UActorComponent* Component)
+    {
+        return Component->GetFName() == SourceName;
+    }) };
+    // Shrinking removed the source component itself; that's not a valid reduction
+    if (!source) { return false; }
+
+    const FDependencyHarnessQuery query{ *source, Dependency };
+    const FDependencyFulfilledResult expected{ FDependencyUtils::CheckDependency(query.Component, query.Dependency) };
+    const TArray<FDependencyFulfilledResult> actual{ Engine(MakeArrayView(&query, 1)) };
+
+    return actual.Num() != 1 || !IsSameResult(expected, actual[0]);
+}
+
+FDependencyDifferentialHarness::FCaseSpec FDependencyDifferentialHarness::RemoveNode(const FCaseSpec& Case, int32 NodeIndex)
+{
+    FCaseSpec result{ Case };
+    const int32 removedParent{ Case.Nodes[NodeIndex].Parent };
+    result.Nodes.RemoveAt(NodeIndex);
+
+    // Children of the removed node move up to its parent; parents always precede their children
+    for (FNodeSpec& node : result.Nodes)
+    {
+        if (node.Parent == NodeIndex) { node.Parent = removedParent; }
+        else if (node.Parent > NodeIndex) { --node.Parent; }
+    }
+
+    return result;
+}
+
+void FDependencyDifferentialHarness::Shrink(
+FCaseSpec& Case,
+FName SourceName,
+FComponentDependency& Dependency,
+const FDependencyEvaluationEngine& Engine)
+{
+    bool changed{ true };
+    while (changed)
+    {
+        changed = false;
+
+        for (int32 i{ Case.Nodes.Num() - 1 }; i >= 0; --i)
+        {
+            FCaseSpec candidate{ RemoveNode(Case, i) };
+            if (!Diverges(candidate, SourceName, Dependency, Engine)) { continue; }
+
+            Case = MoveTemp(candidate);
+            changed = true;
+        }
+
+        for (int32 i{}; i < Case.Nodes.Num(); ++i)
+        {
+            for (int32 t{ Case.Nodes[i].Tags.Num() - 1 }; t >= 0; --t)
+            {
+                FCaseSpec candidate{ Case };
+                candidate.Nodes[i].Tags.RemoveAt(t);
+                if (!Diverges(candidate, SourceName, Dependency, Engine)) { continue; }
+
+                Case = MoveTemp(candidate);
+                changed = true;
+            }
+
+            if (Case.Nodes[i].OverriddenInChild)
+            {
+                FCaseSpec candidate{ Case };
+                candidate.Nodes[i].OverriddenInChild = false;
+                candidate.Nodes[i].OverrideTags.Reset();
+                if (Diverges(candidate, SourceName, Dependency, Engine))
+                {
+                    Case = MoveTemp(candidate);
+                    changed = true;
+                }
+            }
+        }
+
+        if (Case.UseChildBlueprint)
+        {
+            FCaseSpec candidate{ Case };
+            candidate.UseChildBlueprint = false;
+            for (FNodeSpec& node : candidate.Nodes)
+            {
+                node.InChildBlueprint = false;
+                node.OverriddenInChild = false;
+                node.OverrideTags.Reset();
+            }
+
+            if (Diverges(candidate, SourceName, Dependency, Engine))
+            {
+                Case = MoveTemp(candidate);
+                changed = true;
+            }
+        }
+
+        if (Case.NativeParentClass != AActor::StaticClass())
+        {
+            FCaseSpec candidate{ Case };
+            candidate.NativeParentClass = AActor::StaticClass();
+            if (Diverges(candidate, SourceName, Dependency, Engine))
+            {
+                Case = MoveTemp(candidate);
+                changed = true;
+            }
+        }
+
+        if (!Dependency.Meta.IsNone())
+        {
+            FComponentDependency candidate{ Dependency };
+            candidate.Meta = NAME_None;
+            if (Diverges(Case, SourceName, candidate, Engine))
+            {
+                Dependency = candidate;
+                changed = true;
+            }
+        }
+
+        if (!Dependency.TagQuery.IsEmpty())
+        {
+            FComponentDependency candidate{ Dependency };
+            candidate.TagQuery = FGameplayTagQuery{};
+            if (Diverges(Case, SourceName, candidate, Engine))
+            {
+                Dependency = candidate;
+                changed = true;
+            }
+        }
+    }
+}
+
+FString FDependencyDifferentialHarness::DescribeCase(const FCaseSpec& Case, FName SourceName, const FComponentDependency& Dependency)
+{
+    FString result{ FString::Printf(
+    TEXT("  Parent class: %s%s\n"),
+    *Case.NativeParentClass->GetName(),
+    Case.UseChildBlueprint ? TEXT(" (with child blueprint)") : TEXT("")) };
+
+    for (int32 i{}; i < Case.Nodes.Num(); ++i)
+    {
+        const FNodeSpec& node{ Case.Nodes[i] };
+
+        TArray<FString> tagStrings{};
+        for (const FName& tag : node.Tags)
+        {
+            tagStrings.Add(tag.ToString());
+        }
+
+        TArray<FString> overrideTagStrings{};
+        for (const FName& tag : node.OverrideTags)
+        {
+            overrideTagStrings.Add(tag.ToString());
+        }
+
+        result += FString::Printf(
+        TEXT("  [%d] %s : %s, parent %d, tags (%s)%s%s\n"),
+        i,
+        *node.Name.ToString(),
+        *node.Class->GetName(),
+        node.Parent,
+        *FString::Join(tagStrings, TEXT(", ")),
+        node.InChildBlueprint ? TEXT(", in child blueprint") : TEXT(""),
+        node.OverriddenInChild
+            ? *FString::Printf(TEXT(", overridden in child blueprint with tags (%s)"), *FString::Join(overrideTagStrings, TEXT(", ")))
+            : TEXT(""));
+    }
+
+    result += FString::Printf(
+    TEXT("  Source: %s\n  Dependency: %s on %s, tag '%s', tag query '%s', %s"),
+    *SourceName.ToString(),
+    *UEnum::GetValueAsString(Dependency.Position),
+    Dependency.HasClass() ? *Dependency.GetClassName() : TEXT("<null>"),
+    *Dependency.Meta.ToString(),
+    *Dependency.TagQuery.GetDescription(),
+    *UEnum::GetValueAsString(Dependency.Type));
+
+    return result;
+}
+
+static FAutoConsoleCommand GRunDifferentialHarnessCommand(
+TEXT("CompDep.RunDifferentialHarness"),
+TEXT("Compares all registered dependency evaluation engines against the reference implementation. Args: [Iterations=100] [Seed=0]"),
+FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+{
+    const int32 iterations{ Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 100 };
+    const int32 seed{ Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 0 };
+    FDependencyDifferentialHarness::Run(iterations, seed);
+}));
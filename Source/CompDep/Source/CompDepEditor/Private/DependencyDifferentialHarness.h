@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FDependencyUtils.h"
+
+struct FDependencyHarnessQuery
+{
+    const UActorComponent* Component{};
+    FComponentDependency Dependency{};
+};
+
+// An alternative evaluation engine; receives all queries against a single blueprint at once
+// and must return exactly one result per query, in order.
+using FDependencyEvaluationEngine = TFunction<TArray<FDependencyFulfilledResult>(TConstArrayView<FDependencyHarnessQuery> Queries)>;
+// Creates a fresh engine for every harness run, so any state an engine keeps lives exactly as long as a scan would
+using FDependencyEvaluationEngineFactory = TFunction<FDependencyEvaluationEngine()>;
+
+/*
+ * Randomized differential test harness. Generates transient blueprints with varied component sets,
+ * tags and SCS trees, then runs FDependencyUtils::CheckDependency as the reference oracle against every
+ * registered engine. Any divergence is shrunk down to a minimal case and logged.
+ *
+ * Run it from the editor console with: CompDep.RunDifferentialHarness [Iterations] [Seed]
+ */
+class FDependencyDifferentialHarness
+{
+public:
+    static void RegisterEngine(FName Name, FDependencyEvaluationEngineFactory Factory);
+    static void UnregisterEngine(FName Name);
+
+    // Returns the amount of diverging cases found across all engines
+    static int32 Run(int32 Iterations, int32 Seed);
+
+private:
+    struct FNodeSpec
+    {
+        FName Name{};
+        UClass* Class{};
+        // Child blueprint nodes may also be parented to parent blueprint nodes, which attaches them to the inherited node
+        int32 Parent{ INDEX_NONE };
+        TArray<FName> Tags{};
+        bool InChildBlueprint{ false };
+
+        // Parent blueprint nodes only; the child blueprint overrides the template through its InheritableComponentHandler
+        bool OverriddenInChild{ false };
+        TArray<FName> OverrideTags{};
+    };
+
+    struct FCaseSpec
+    {
+        UClass* NativeParentClass{};
+        bool UseChildBlueprint{ false };
+        TArray<FNodeSpec> Nodes{};
+    };
+
+    struct FBuiltCase
+    {
+        UBlueprintGeneratedClass* BlueprintGC{};
+        TArray<UActorComponent*> Components{};
+    };
+
+    static FCaseSpec GenerateCase(FRandomStream& Random);
+    static FComponentDependency GenerateDependency(FRandomStream& Random);
+    static FBuiltCase BuildCase(const FCaseSpec& Case);
+    static UBlueprint* CreateBlueprint(UClass* ParentClass);
+    static void ReleaseBlueprints();
+
+    static bool IsSameResult(const FDependencyFulfilledResult& A, const FDependencyFulfilledResult& B);
+    static bool Diverges(
+    const FCaseSpec& Case,
+    FName SourceName,
+    const FComponentDependency& Dependency,
+    const FDependencyEvaluationEngine& Engine);
+
+    static FCaseSpec RemoveNode(const FCaseSpec& Case, int32 NodeIndex);
+    static void Shrink(
+    FCaseSpec& Case,
+    FName SourceName,
+    FComponentDependency& Dependency,
+    const FDependencyEvaluationEngine& Engine);
+
+    static FString DescribeCase(const FCaseSpec& Case, FName SourceName, const FComponentDependency& Dependency);
+
+    static TMap<FName, FDependencyEvaluationEngineFactory> EngineFactories;
+    // Everything created during a run, released at its end
+    static TArray<TWeakObjectPtr<UBlueprint>> CreatedBlueprints;
+};
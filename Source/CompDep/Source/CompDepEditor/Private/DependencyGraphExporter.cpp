@@ -0,0 +1,418 @@
+#include "DependencyGraphExporter.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCompDepExport, Log, All);
+
+namespace
+{
+    // One row of the flattened graph: a dependency, a transitive issue or a child actor cycle, on the
+    // evaluated blueprint itself or on one of its child actors
+    struct FExportRecord
+    {
+        // Path of ChildActorComponent names from the blueprint down, e.g. "Turret/Barrel"; empty for the blueprint itself
+        FString ChildActor{};
+        // 0 for the blueprint itself, 1 for its own child actors
+        int32 Depth{};
+        FString Component{};
+        FString ComponentClass{};
+        FString Position{};
+        FString DependencyClass{};
+        FString Tag{};
+        FString Type{};
+        FString Status{};
+        FString Message{};
+    };
+
+    FString GetStatusString(const FCompactDependencyResult& Result)
+    {
+        if (!Result.ShowDependency) { return TEXT("hidden"); }
+        if (Result.IsFulfilled) { return TEXT("fulfilled"); }
+        return Result.Type == EComponentDependencyType::Optional ? TEXT("optional_missing") : TEXT("missing");
+    }
+
+    FString GetEnumString(EComponentDependencyPosition Position)
+    {
+        return StaticEnum<EComponentDependencyPosition>()->GetNameStringByValue(static_cast<int64>(Position));
+    }
+
+    FString GetEnumString(EComponentDependencyType Type)
+    {
+        return StaticEnum<EComponentDependencyType>()->GetNameStringByValue(static_cast<int64>(Type));
+    }
+
+    void AddComponentRecords(
+    const TArray<FCompactComponentResult>& Components,
+    const TArray<FTransitiveDependencyIssue>& TransitiveIssues,
+    const FString& ChildActor,
+    int32 Depth,
+    TArray<FExportRecord>& OutRecords)
+    {
+        for (const FCompactComponentResult& component : Components)
+        {
+            for (const FCompactDependencyResult& dependency : component.QueriedDependencies)
+            {
+                OutRecords.Add({
+                    ChildActor,
+                    Depth,
+                    component.ComponentName.ToString(),
+                    component.ComponentClass.ToString(),
+                    GetEnumString(dependency.Position),
+                    dependency.Class.ToString(),
+                    dependency.GetTagString(),
+                    GetEnumString(dependency.Type),
+                    GetStatusString(dependency),
+                    dependency.OutputString,
+                });
+            }
+        }
+
+        // Indirect requirements have no position or tag of their own
+        for (const FTransitiveDependencyIssue& issue : TransitiveIssues)
+        {
+            OutRecords.Add({
+                ChildActor,
+                Depth,
+                issue.ComponentName.ToString(),
+                issue.ComponentClass.ToString(),
+                {},
+                issue.MissingClass.ToString(),
+                {},
+                GetEnumString(EComponentDependencyType::Required),
+                issue.IsCycle ? TEXT("transitive_cycle") : TEXT("transitive_missing"),
+                issue.OutputString,
+            });
+        }
+    }
+
+    TArray<FExportRecord> MakeRecords(const FCompactBlueprintResult& Result)
+    {
+        TArray<FExportRecord> records{};
+        AddComponentRecords(Result.QueriedComponents, Result.TransitiveIssues, {}, 0, records);
+
+        for (int32 i{}; i < Result.ChildActors.Num(); ++i)
+        {
+            const FCompactChildActorResult& childActor{ Result.ChildActors[i] };
+            const FString childActorPath{ Result.GetChildActorPath(i) };
+            if (childActor.IsCycle)
+            {
+                FExportRecord& cycle{ records.AddDefaulted_GetRef() };
+                cycle.ChildActor = childActorPath;
+                cycle.Depth = childActor.Depth + 1;
+                cycle.DependencyClass = childActor.ChildActorClass.ToString();
+                cycle.Status = TEXT("child_actor_cycle");
+                cycle.Message = FString::Printf(TEXT("%s spawns itself through its child actors"), *childActor.ChildActorClass.GetAssetName());
+                continue;
+            }
+
+            AddComponentRecords(childActor.QueriedComponents, childActor.TransitiveIssues, childActorPath, childActor.Depth + 1, records);
+        }
+        return records;
+    }
+
+    class FTextLineWriter : public IDependencyGraphWriter
+    {
+    public:
+        explicit FTextLineWriter(FArchive& InArchive) : Archive{ InArchive } {}
+
+    protected:
+        void WriteLine(const FString& Line) const
+        {
+            const FTCHARToUTF8 utf8{ *(Line + TEXT("\n")) };
+            Archive.Serialize((void*)utf8.Get(), utf8.Length());
+        }
+
+    private:
+        FArchive& Archive;
+    };
+
+    class FJsonLinesWriter final : public FTextLineWriter
+    {
+    public:
+        using FTextLineWriter::FTextLineWriter;
+
+        virtual void WriteBlueprint(const FCompactBlueprintResult& Result) override
+        {
+            const FString blueprint{ Escape(Result.BlueprintGC.ToString()) };
+            for (const FExportRecord& record : MakeRecords(Result))
+            {
+                WriteLine(FString::Printf(
+                TEXT("{\"blueprint\":\"%s\",\"childActor\":\"%s\",\"depth\":%d,\"component\":\"%s\",\"componentClass\":\"%s\",\"position\":\"%s\",")
+                TEXT("\"dependencyClass\":\"%s\",\"tag\":\"%s\",\"type\":\"%s\",\"status\":\"%s\",\"message\":\"%s\"}"),
+                *blueprint,
+                *Escape(record.ChildActor),
+                record.Depth,
+                *Escape(record.Component),
+                *Escape(record.ComponentClass),
+                *record.Position,
+                *Escape(record.DependencyClass),
+                *Escape(record.Tag),
+                *record.Type,
+                *record.Status,
+                *Escape(record.Message)));
+            }
+        }
+
+    private:
+        static FString Escape(const FString& Value)
+        {
+            FString result{};
+            result.Reserve(Value.Len());
+            for (const TCHAR character : Value)
+            {
+                switch (character)
+                {
+                case TEXT('"'): result += TEXT("\\\""); break;
+                case TEXT('\\'): result += TEXT("\\\\"); break;
+                case TEXT('\n'): result += TEXT("\\n"); break;
+                case TEXT('\r'): result += TEXT("\\r"); break;
+                case TEXT('\t'): result += TEXT("\\t"); break;
+                default:
+                    if (character < 0x20) { result += FString::Printf(TEXT("\\u%04x"), static_cast<int32>(character)); }
+                    else { result.AppendChar(character); }
+                }
+            }
+            return result;
+        }
+    };
+
+    class FCsvWriter final : public FTextLineWriter
+    {
+    public:
+        using FTextLineWriter::FTextLineWriter;
+
+        virtual void Begin() override
+        {
+            WriteLine(TEXT("Blueprint,ChildActor,Depth,Component,ComponentClass,Position,DependencyClass,Tag,Type,Status,Message"));
+        }
+
+        virtual void WriteBlueprint(const FCompactBlueprintResult& Result) override
+        {
+            const FString blueprint{ Escape(Result.BlueprintGC.ToString()) };
+            for (const FExportRecord& record : MakeRecords(Result))
+            {
+                WriteLine(FString::Join(TArray<FString>{
+                    blueprint,
+                    Escape(record.ChildActor),
+                    FString::FromInt(record.Depth),
+                    Escape(record.Component),
+                    Escape(record.ComponentClass),
+                    record.Position,
+                    Escape(record.DependencyClass),
+                    Escape(record.Tag),
+                    record.Type,
+                    record.Status,
+                    Escape(record.Message),
+                }, TEXT(",")));
+            }
+        }
+
+    private:
+        static FString Escape(const FString& Value)
+        {
+            const bool needsQuotes{
+                Value.Contains(TEXT(",")) || Value.Contains(TEXT("\"")) || Value.Contains(TEXT("\n")) || Value.Contains(TEXT("\r"))
+            };
+            if (!needsQuotes) { return Value; }
+            return TEXT("\"") + Value.Replace(TEXT("\""), TEXT("\"\"")) + TEXT("\"");
+        }
+    };
+
+    class FDotWriter final : public FTextLineWriter
+    {
+    public:
+        using FTextLineWriter::FTextLineWriter;
+
+        virtual void Begin() override
+        {
+            WriteLine(TEXT("digraph ComponentDependencies {"));
+            WriteLine(TEXT("    rankdir=LR;"));
+            WriteLine(TEXT("    node [shape=box];"));
+        }
+
+        virtual void WriteBlueprint(const FCompactBlueprintResult& Result) override
+        {
+            const FString blueprintPath{ Result.BlueprintGC.ToString() };
+            WriteLine(FString::Printf(
+            TEXT("    \"%s\" [label=\"%s\", style=filled, fillcolor=lightblue];"),
+            *Escape(blueprintPath),
+            *Escape(Result.BlueprintGC.GetAssetName())));
+            WriteComponents(blueprintPath, Result.QueriedComponents, Result.TransitiveIssues);
+
+            // Child actors are unique per blueprint as well, and hang off their parent child actor
+            TArray<FString> childActorIds{};
+            childActorIds.Reserve(Result.ChildActors.Num());
+            for (int32 i{}; i < Result.ChildActors.Num(); ++i)
+            {
+                const FCompactChildActorResult& childActor{ Result.ChildActors[i] };
+                const FString parentId{ childActor.ParentIndex == INDEX_NONE ? blueprintPath : childActorIds[childActor.ParentIndex] };
+                const FString childActorId{ blueprintPath + TEXT(":") + Result.GetChildActorPath(i) };
+                childActorIds.Add(childActorId);
+
+                WriteLine(FString::Printf(
+                TEXT("    \"%s\" [label=\"%s\\n(%s)\", style=filled, fillcolor=lightcyan];"),
+                *Escape(childActorId),
+                *Escape(childActor.ComponentName.ToString()),
+                *Escape(childActor.ChildActorClass.GetAssetName())));
+                WriteLine(FString::Printf(TEXT("    \"%s\" -> \"%s\" [style=bold];"), *Escape(parentId), *Escape(childActorId)));
+
+                // The spawned class is its own blueprint node, so cycles close on it
+                if (childActor.IsCycle)
+                {
+                    WriteLine(FString::Printf(
+                    TEXT("    \"%s\" -> \"%s\" [label=\"cycle\", color=red, fontcolor=red, style=dashed];"),
+                    *Escape(childActorId),
+                    *Escape(childActor.ChildActorClass.ToString())));
+                    continue;
+                }
+
+                WriteComponents(childActorId, childActor.QueriedComponents, childActor.TransitiveIssues);
+            }
+        }
+
+        virtual void End() override
+        {
+            WriteLine(TEXT("}"));
+        }
+
+    private:
+        void WriteComponents(
+        const FString& OwnerId,
+        const TArray<FCompactComponentResult>& Components,
+        const TArray<FTransitiveDependencyIssue>& TransitiveIssues) const
+        {
+            TSet<FString> writtenComponents{};
+            for (const FCompactComponentResult& component : Components)
+            {
+                // Components are unique per owner, dependency classes are shared between all of them
+                const FString componentId{ WriteComponentNode(OwnerId, component.ComponentName, component.ComponentClass, writtenComponents) };
+
+                for (const FCompactDependencyResult& dependency : component.QueriedDependencies)
+                {
+                    if (!dependency.ShowDependency) { continue; }
+
+                    const TCHAR* color{
+                        dependency.IsFulfilled
+                            ? TEXT("darkgreen")
+                            : dependency.Type == EComponentDependencyType::Optional ? TEXT("gray") : TEXT("red")
+                    };
+                    WriteLine(FString::Printf(
+                    TEXT("    \"%s\" -> \"%s\" [label=\"%s\", color=%s, fontcolor=%s];"),
+                    *Escape(componentId),
+                    *Escape(dependency.Class.ToString()),
+                    *Escape(dependency.OutputString),
+                    color,
+                    color));
+                }
+            }
+
+            // Indirect requirements are dashed; cycles point back at the component's own class
+            for (const FTransitiveDependencyIssue& issue : TransitiveIssues)
+            {
+                const FString componentId{ WriteComponentNode(OwnerId, issue.ComponentName, issue.ComponentClass, writtenComponents) };
+                const TSoftClassPtr<UActorComponent>& target{ issue.IsCycle ? issue.ComponentClass : issue.MissingClass };
+                WriteLine(FString::Printf(
+                TEXT("    \"%s\" -> \"%s\" [label=\"%s\", color=red, fontcolor=red, style=dashed];"),
+                *Escape(componentId),
+                *Escape(target.ToString()),
+                *Escape(issue.OutputString)));
+            }
+        }
+
+        // A component with both direct and transitive results is only written once
+        FString WriteComponentNode(
+        const FString& OwnerId,
+        FName ComponentName,
+        const TSoftClassPtr<UActorComponent>& ComponentClass,
+        TSet<FString>& WrittenComponents) const
+        {
+            const FString componentId{ OwnerId + TEXT(":") + ComponentName.ToString() };
+            bool alreadyWritten{ false };
+            WrittenComponents.Add(componentId, &alreadyWritten);
+            if (alreadyWritten) { return componentId; }
+
+            WriteLine(FString::Printf(
+            TEXT("    \"%s\" [label=\"%s\\n(%s)\"];"),
+            *Escape(componentId),
+            *Escape(ComponentName.ToString()),
+            *Escape(ComponentClass.GetAssetName())));
+            WriteLine(FString::Printf(TEXT("    \"%s\" -> \"%s\";"), *Escape(OwnerId), *Escape(componentId)));
+            return componentId;
+        }
+
+        static FString Escape(const FString& Value)
+        {
+            return Value.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\""));
+        }
+    };
+}
+
+bool FDependencyGraphExporter::Export(const FString& FilePath, EDependencyGraphExportFormat Format)
+{
+    return Export(FilePath, Format, FDependencyScanner::GetAllBlueprintAssets());
+}
+
+bool FDependencyGraphExporter::Export(const FString& FilePath, EDependencyGraphExportFormat Format, const TArray<FAssetData>& Assets)
+{
+    const TUniquePtr<FArchive> archive{ IFileManager::Get().CreateFileWriter(*FilePath) };
+    if (!archive)
+    {
+        UE_LOG(LogCompDepExport, Error, TEXT("Couldn't open %s for writing"), *FilePath);
+        return false;
+    }
+
+    const TUniquePtr<IDependencyGraphWriter> writer{ MakeWriter(Format, *archive) };
+    writer->Begin();
+    FDependencyScanner::Scan(Assets, [&writer](const FCompactBlueprintResult& Result)
+    {
+        writer->WriteBlueprint(Result);
+    });
+    writer->End();
+
+    if (!archive->Close())
+    {
+        UE_LOG(LogCompDepExport, Error, TEXT("Failed writing dependency graph to %s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogCompDepExport, Display, TEXT("Exported dependency graph to %s"), *FilePath);
+    return true;
+}
+
+TUniquePtr<IDependencyGraphWriter> FDependencyGraphExporter::MakeWriter(EDependencyGraphExportFormat Format, FArchive& Archive)
+{
+    switch (Format)
+    {
+    case EDependencyGraphExportFormat::JsonLines: return MakeUnique<FJsonLinesWriter>(Archive);
+    case EDependencyGraphExportFormat::Csv: return MakeUnique<FCsvWriter>(Archive);
+    case EDependencyGraphExportFormat::Dot: return MakeUnique<FDotWriter>(Archive);
+    }
+
+    checkNoEntry();
+    return nullptr;
+}
+
+bool FDependencyGraphExporter::TryGetFormatFromExtension(const FString& FilePath, EDependencyGraphExportFormat& OutFormat)
+{
+    const FString extension{ FPaths::GetExtension(FilePath).ToLower() };
+    if (extension == TEXT("jsonl") || extension == TEXT("json")) { OutFormat = EDependencyGraphExportFormat::JsonLines; return true; }
+    if (extension == TEXT("csv")) { OutFormat = EDependencyGraphExportFormat::Csv; return true; }
+    if (extension == TEXT("dot") || extension == TEXT("gv")) { OutFormat = EDependencyGraphExportFormat::Dot; return true; }
+    return false;
+}
+
+static FAutoConsoleCommand GExportDependencyGraphCommand(
+TEXT("CompDep.ExportGraph"),
+TEXT("Exports the full evaluated dependency graph. Args: <FilePath ending in .jsonl, .csv or .dot>"),
+FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+{
+    EDependencyGraphExportFormat format{};
+    if (!Args.IsValidIndex(0) || !FDependencyGraphExporter::TryGetFormatFromExtension(Args[0], format))
+    {
+        UE_LOG(LogCompDepExport, Error, TEXT("Usage: CompDep.ExportGraph <FilePath ending in .jsonl, .csv or .dot>"));
+        return;
+    }
+
+    FDependencyGraphExporter::Export(Args[0], format);
+}));
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DependencyScanner.h"
+#include "DependencyGraphExporter.generated.h"
+
+UENUM(BlueprintType)
+enum class EDependencyGraphExportFormat : uint8
+{
+    JsonLines UMETA(ToolTip="One JSON object per dependency or issue, one per line"),
+    Csv UMETA(ToolTip="One row per dependency or issue, with a header row"),
+    Dot UMETA(ToolTip="Graphviz digraph of blueprints, child actors, components and dependency classes"),
+};
+
+// Receives evaluated blueprints one at a time and writes them out immediately
+class IDependencyGraphWriter
+{
+public:
+    virtual ~IDependencyGraphWriter() = default;
+
+    virtual void Begin() {}
+    virtual void WriteBlueprint(const FCompactBlueprintResult& Result) = 0;
+    virtual void End() {}
+};
+
+/*
+ * Exports the evaluated dependency graph (blueprints -> child actors -> components -> dependencies -> status),
+ * including transitive issues and child actor cycles. Records are written as FDependencyScanner evaluates
+ * each blueprint, so neither the full result set nor the full output text is ever held in memory. Whenever
+ * the memory grown since the scan started exceeds ScanMemoryBudgetMB, the scanner releases the blueprints
+ * it loaded and drops its memoized results, so peak memory stays around that budget rather than growing
+ * with the project size.
+ */
+class FDependencyGraphExporter
+{
+public:
+    static bool Export(const FString& FilePath, EDependencyGraphExportFormat Format);
+    static bool Export(const FString& FilePath, EDependencyGraphExportFormat Format, const TArray<FAssetData>& Assets);
+
+    static TUniquePtr<IDependencyGraphWriter> MakeWriter(EDependencyGraphExportFormat Format, FArchive& Archive);
+    static bool TryGetFormatFromExtension(const FString& FilePath, EDependencyGraphExportFormat& OutFormat);
+};
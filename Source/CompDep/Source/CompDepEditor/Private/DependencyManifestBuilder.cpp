@@ -0,0 +1,158 @@
+#include "DependencyManifestBuilder.h"
+
+#include "DependencyScanner.h"
+#include "GameDelegates.h"
+#include "CompDep/Public/ComponentDependencies.h"
+#include "CompDep/Public/ComponentDependencyManifest.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/PackageName.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCompDepManifest, Log, All);
+
+bool FDependencyManifestBuilder::IsCookHookBound{ false };
+
+void FDependencyManifestBuilder::RegisterCookHook()
+{
+    FCookModificationDelegate& cookDelegate{ FGameDelegates::Get().GetCookModificationDelegate() };
+
+    // This is a single-cast delegate; never replace a project's own binding
+    if (cookDelegate.IsBound())
+    {
+        UE_LOG(
+        LogCompDepManifest,
+        Log,
+        TEXT("Cook modification delegate is already bound; run the CompDepManifest commandlet before cooking instead."));
+        return;
+    }
+
+    cookDelegate.BindStatic(&FDependencyManifestBuilder::OnCookModification);
+    IsCookHookBound = true;
+}
+
+void FDependencyManifestBuilder::UnregisterCookHook()
+{
+    if (!IsCookHookBound) { return; }
+
+    FGameDelegates::Get().GetCookModificationDelegate().Unbind();
+    IsCookHookBound = false;
+}
+
+void FDependencyManifestBuilder::Build(FComponentDependencyManifest& OutManifest)
+{
+    OutManifest.Reset();
+    const FDependencyScanner::FScanScope scanScope{};
+
+    // Native classes are always loaded; Blueprint classes have to be loaded to call GetDependencies,
+    // but only the ones that can implement the interface
+    IAssetRegistry& assetRegistry{ FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get() };
+    assetRegistry.WaitForCompletion();
+
+    for (const FTopLevelAssetPath& classPath : FindBlueprintImplementers(assetRegistry))
+    {
+        LoadObject<UClass>(nullptr, *classPath.ToString());
+    }
+
+    TArray<UClass*> implementingClasses{};
+    for (TObjectIterator<UClass> it; it; ++it)
+    {
+        UClass* current{ *it };
+        if (!current->ImplementsInterface(UComponentDependencies::StaticClass())) { continue; }
+        if (current->HasAnyClassFlags(CLASS_NewerVersionExists | CLASS_Deprecated)) { continue; }
+        if (FKismetEditorUtilities::IsClassABlueprintSkeleton(current)) { continue; }
+        // Transient classes (e.g. from the differential harness) never make it into a build
+        if (current->GetOutermost() == GetTransientPackage()) { continue; }
+
+        implementingClasses.Add(current);
+    }
+
+    // Keep the output stable between cooks
+    implementingClasses.Sort([](const UClass& A, const UClass& B)
+    {
+        return A.GetPathName() < B.GetPathName();
+    });
+
+    for (const UClass* implementingClass : implementingClasses)
+    {
+        const UObject* cdo{ implementingClass->GetDefaultObject() };
+        OutManifest.AddClass(implementingClass, IComponentDependencies::Execute_GetDependencies(cdo));
+    }
+}
+
+bool FDependencyManifestBuilder::BuildAndSave()
+{
+    FComponentDependencyManifest manifest{};
+    Build(manifest);
+
+    const FString path{ FComponentDependencyManifest::GetManifestPath() };
+    if (!manifest.SaveToFile(path))
+    {
+        UE_LOG(LogCompDepManifest, Error, TEXT("Couldn't write component dependency manifest to %s"), *path);
+        return false;
+    }
+
+    UE_LOG(LogCompDepManifest, Display, TEXT("Wrote component dependency manifest with %d classes to %s"), manifest.Num(), *path);
+
+    // Anything that already read the manifest this session should see the new one
+    FComponentDependencyManifest::Get() = MoveTemp(manifest);
+    return true;
+}
+
+TArray<FTopLevelAssetPath> FDependencyManifestBuilder::FindBlueprintImplementers(IAssetRegistry& AssetRegistry)
+{
+    // Blueprints list the interfaces they implement themselves in their asset tags
+    const FString interfacePath{ UComponentDependencies::StaticClass()->GetPathName() };
+
+    TSet<FTopLevelAssetPath> implementers{};
+    for (TObjectIterator<UClass> it; it; ++it)
+    {
+        if (it->HasAnyClassFlags(CLASS_Native) && it->ImplementsInterface(UComponentDependencies::StaticClass()))
+        {
+            implementers.Add(it->GetClassPathName());
+        }
+    }
+
+    FARFilter filter{};
+    filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+    filter.bRecursiveClasses = true;
+    filter.TagsAndValues.Add(FBlueprintTags::ImplementedInterfaces, TOptional<FString>{});
+
+    TArray<FAssetData> blueprintAssets{};
+    AssetRegistry.GetAssets(filter, blueprintAssets);
+    for (const FAssetData& blueprintAsset : blueprintAssets)
+    {
+        const FString interfaces{ blueprintAsset.GetTagValueRef<FString>(FBlueprintTags::ImplementedInterfaces) };
+        if (!interfaces.Contains(interfacePath)) { continue; }
+
+        const FString generatedClass{ blueprintAsset.GetTagValueRef<FString>(FBlueprintTags::GeneratedClassPath) };
+        if (generatedClass.IsEmpty()) { continue; }
+        implementers.Add(FTopLevelAssetPath{ FPackageName::ExportTextPathToObjectPath(generatedClass) });
+    }
+
+    // Blueprints deriving from an implementer inherit the interface without listing it
+    TSet<FTopLevelAssetPath> derivedClassPaths{};
+    AssetRegistry.GetDerivedClassNames(implementers.Array(), {}, derivedClassPaths);
+
+    TArray<FTopLevelAssetPath> result{};
+    for (const FTopLevelAssetPath& classPath : implementers.Union(derivedClassPaths))
+    {
+        // Native classes are loaded already
+        if (FindObject<UClass>(classPath)) { continue; }
+        result.Add(classPath);
+    }
+    return result;
+}
+
+static FAutoConsoleCommand GRebuildManifestCommand(
+TEXT("CompDep.RebuildManifest"),
+TEXT("Rebuilds the runtime component dependency manifest from the current declarations."),
+FConsoleCommandDelegate::CreateLambda([]()
+{
+    FDependencyManifestBuilder::BuildAndSave();
+}));
+
+void FDependencyManifestBuilder::OnCookModification(TArray<FString>& ExtraPackagesToCook)
+{
+    BuildAndSave();
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FComponentDependencyManifest;
+class IAssetRegistry;
+
+/*
+ * Bakes every IComponentDependencies implementation's declarations into the runtime manifest.
+ * Runs automatically when cooking (through the cook modification delegate), or manually with
+ * the CompDepManifest commandlet if a project already uses that delegate itself. In the editor, the
+ * CompDep.RebuildManifest console command does the same; nothing is rebuilt implicitly.
+ */
+class FDependencyManifestBuilder
+{
+public:
+    static void RegisterCookHook();
+    static void UnregisterCookHook();
+
+    static void Build(FComponentDependencyManifest& OutManifest);
+    static bool BuildAndSave();
+
+private:
+    static void OnCookModification(TArray<FString>& ExtraPackagesToCook);
+    static TArray<FTopLevelAssetPath> FindBlueprintImplementers(IAssetRegistry& AssetRegistry);
+
+    static bool IsCookHookBound;
+};
@@ -0,0 +1,379 @@
+#include "DependencyScanner.h"
+
+#include "CompDepSettings.h"
+#include "CompDep/Public/ComponentDependencies.h"
+#include "CollectionManagerModule.h"
+#include "Editor.h"
+#include "FileHelpers.h"
+#include "ICollectionManager.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Components/ChildActorComponent.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "UObject/UObjectHash.h"
+
+#define LOCTEXT_NAMESPACE "DependencyScanner"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCompDepScan, Log, All);
+
+int32 FDependencyScanner::ActiveScans{ 0 };
+
+FDependencyScanner::FScanScope::FScanScope()
+{
+    ++ActiveScans;
+}
+
+FDependencyScanner::FScanScope::~FScanScope()
+{
+    --ActiveScans;
+}
+
+bool FDependencyScanner::IsScanning()
+{
+    return ActiveScans > 0;
+}
+
+void FDependencyScanner::Scan(const TArray<FAssetData>& Assets, FOnBlueprintEvaluated OnEvaluated)
+{
+    const UCompDepSettings* settings{ GetDefault<UCompDepSettings>() };
+    const int32 batchSize{ FMath::Max(1, settings->ScanBatchSize) };
+    const uint64 memoryBudgetBytes{ static_cast<uint64>(settings->ScanMemoryBudgetMB) * 1024 * 1024 };
+    const uint64 usedAtStart{ FPlatformMemory::GetStats().UsedPhysical };
+    const double startTime{ FPlatformTime::Seconds() };
+    const FScanScope scanScope{};
+
+    FScopedSlowTask slowTask{ static_cast<float>(Assets.Num()), LOCTEXT("ScanningBlueprints", "Checking component dependencies...") };
+    slowTask.MakeDialogDelayed(1.f);
+
+    FDependencyScanState state{};
+    if (settings->EnableTransitiveChecks) { state.TransitiveGraph.Emplace(); }
+
+    for (int32 batchStart{}; batchStart < Assets.Num(); batchStart += batchSize)
+    {
+        const int32 batchEnd{ FMath::Min(batchStart + batchSize, Assets.Num()) };
+        for (int32 i{ batchStart }; i < batchEnd; ++i)
+        {
+            slowTask.EnterProgressFrame();
+
+            FCompactBlueprintResult result{};
+            if (!EvaluateBlueprint(Assets[i], result, &state)) { continue; }
+
+            OnEvaluated(result);
+        }
+
+        // Nothing loaded for this batch is referenced anymore; only pay for a GC once we're over budget
+        const uint64 used{ FPlatformMemory::GetStats().UsedPhysical };
+        if (used > usedAtStart && used - usedAtStart > memoryBudgetBytes)
+        {
+            ReleaseLoadedPackages(state);
+        }
+    }
+
+    // For comparing scan times across settings and changes; GC time is included
+    UE_LOG(LogCompDepScan, Display, TEXT("Scanned %d blueprints in %.2fs: %d dependency results reused, %d evaluated"),
+    Assets.Num(),
+    FPlatformTime::Seconds() - startTime,
+    state.ResultCache.GetHitCount(),
+    state.ResultCache.GetMissCount());
+}
+
+void FDependencyScanner::ReleaseLoadedPackages(FDependencyScanState& State)
+{
+    // Memoized results only hold class paths, but grow with every structure seen; start them over with the working set
+    State.ResultCache.Reset();
+    State.ContextCache.Reset();
+    State.ChildActorResults.Reset();
+
+    TSet<const UPackage*> editedPackages{};
+    if (GEditor)
+    {
+        for (const UObject* asset : GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->GetAllEditedAssets())
+        {
+            editedPackages.Add(asset->GetPackage());
+        }
+    }
+
+    // Loaded assets are RF_Standalone, which keeps them alive through any GC in the editor
+    for (const TWeakObjectPtr<UPackage>& weakPackage : State.LoadedPackages)
+    {
+        UPackage* package{ weakPackage.Get() };
+        if (!package || package->IsDirty() || editedPackages.Contains(package)) { continue; }
+
+        ForEachObjectWithPackage(package, [](UObject* Object)
+        {
+            Object->ClearFlags(RF_Standalone);
+            return true;
+        });
+    }
+
+    State.LoadedPackages.Reset();
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+bool FDependencyScanner::EvaluateBlueprint(const FAssetData& AssetData, FCompactBlueprintResult& OutResult, FDependencyScanState* State)
+{
+    // Only loads caused by this call are recorded; assets that were loaded before aren't reported again,
+    // and whatever other editor systems load in between (e.g. while the progress dialog pumps) isn't ours
+    FDelegateHandle assetLoadedHandle{};
+    if (State)
+    {
+        assetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddLambda([State](UObject* Asset)
+        {
+            State->LoadedPackages.Add(Asset->GetPackage());
+        });
+    }
+
+    const UBlueprint* blueprintAsset{ Cast<UBlueprint>(AssetData.GetAsset()) };
+    if (State) { FCoreUObjectDelegates::OnAssetLoaded.Remove(assetLoadedHandle); }
+    if (!blueprintAsset) { return false; }
+
+    return EvaluateBlueprint(Cast<UBlueprintGeneratedClass>(blueprintAsset->GeneratedClass), OutResult, State);
+}
+
+bool FDependencyScanner::EvaluateBlueprint(UBlueprintGeneratedClass* BlueprintGC, FCompactBlueprintResult& OutResult, FDependencyScanState* State)
+{
+    OutResult.QueriedComponents.Reset();
+    OutResult.TransitiveIssues.Reset();
+    OutResult.ChildActors.Reset();
+
+    // Without a shared state, child actors are still only evaluated once within this blueprint
+    FDependencyScanState localState{};
+    FDependencyScanState& state{ State ? *State : localState };
+
+    const bool isActorBlueprint{ EvaluateBlueprintComponents(
+    BlueprintGC,
+    state,
+    [&OutResult](UActorComponent* Component, const TArray<FComponentDependency>& Dependencies, const TArray<FDependencyFulfilledResult>& Results)
+    {
+        FCompactComponentResult& componentResult{ OutResult.QueriedComponents.AddDefaulted_GetRef() };
+        componentResult.ComponentName = Component->GetFName();
+        componentResult.ComponentClass = TSoftClassPtr<UActorComponent>{ FSoftObjectPath{ Component->GetClass() } };
+
+        for (int32 i{}; i < Dependencies.Num(); ++i)
+        {
+            const FComponentDependency& dependency{ Dependencies[i] };
+
+            FCompactDependencyResult& dependencyResult{ componentResult.QueriedDependencies.AddDefaulted_GetRef() };
+            dependencyResult.Position = dependency.Position;
+            dependencyResult.Class = TSoftClassPtr<UActorComponent>{ FSoftObjectPath{ dependency.GetClassPath() } };
+            dependencyResult.Meta = dependency.Meta;
+            dependencyResult.Type = dependency.Type;
+            dependencyResult.TagQuery = dependency.TagQuery;
+            dependencyResult.IsFulfilled = Results[i].IsFulfilled;
+            dependencyResult.ShowDependency = Results[i].ShowDependency;
+            dependencyResult.OutputString = Results[i].OutputString;
+        }
+    },
+    OutResult.TransitiveIssues,
+    OutResult.ChildActors) };
+    if (!isActorBlueprint) { return false; }
+
+    OutResult.BlueprintGC = TSoftClassPtr<AActor>{ FSoftObjectPath{ BlueprintGC } };
+    return !OutResult.QueriedComponents.IsEmpty() || !OutResult.ChildActors.IsEmpty();
+}
+
+bool FDependencyScanner::EvaluateBlueprintComponents(
+UBlueprintGeneratedClass* BlueprintGC,
+FDependencyScanState& State,
+FOnComponentEvaluated OnComponentEvaluated,
+TArray<FTransitiveDependencyIssue>& OutTransitiveIssues,
+TArray<FCompactChildActorResult>& OutChildActors)
+{
+    if (!BlueprintGC) { return false; }
+    if (!BlueprintGC->IsChildOf(AActor::StaticClass())) { return false; }
+
+    // The class being evaluated counts as in progress too, so one that spawns itself is cut right away
+    const FTopLevelAssetPath blueprintPath{ BlueprintGC->GetClassPathName() };
+    bool wasInProgress{ false };
+    State.ChildActorsInProgress.Add(blueprintPath, &wasInProgress);
+
+    FDependencyEvaluationBatch batch{ &State.ResultCache, &State.ContextCache };
+
+    TArray<UActorComponent*> components{ FDependencyUtils::GetAllBlueprintComponentsByName(BlueprintGC) };
+    for (UActorComponent* innerComp : components)
+    {
+        if (!innerComp->GetClass()->ImplementsInterface(UComponentDependencies::StaticClass())) { continue; }
+
+        const TArray<FComponentDependency> dependencies{ IComponentDependencies::Execute_GetDependencies(innerComp) };
+        if (dependencies.IsEmpty()) { continue; }
+
+        TArray<FDependencyFulfilledResult> results{};
+        results.Reserve(dependencies.Num());
+        for (const FComponentDependency& dependency : dependencies)
+        {
+            results.Add(batch.CheckDependency(innerComp, dependency));
+        }
+
+        OnComponentEvaluated(innerComp, dependencies, results);
+    }
+
+    // Uses the same component list, so transitive requirements come out of the same pass
+    if (State.TransitiveGraph.IsSet()) { State.TransitiveGraph->FindIssues(components, OutTransitiveIssues); }
+
+    EvaluateChildActors(components, OutChildActors, State);
+    if (!wasInProgress) { State.ChildActorsInProgress.Remove(blueprintPath); }
+    return true;
+}
+
+void FDependencyScanner::EvaluateChildActors(
+const TArray<UActorComponent*>& Components,
+TArray<FCompactChildActorResult>& OutChildActors,
+FDependencyScanState& State)
+{
+    for (const UActorComponent* innerComp : Components)
+    {
+        const UChildActorComponent* childActorComp{ Cast<UChildActorComponent>(innerComp) };
+        if (!childActorComp) { continue; }
+
+        // Native child actor classes have no blueprint components to evaluate
+        UBlueprintGeneratedClass* childGC{ Cast<UBlueprintGeneratedClass>(childActorComp->GetChildActorClass()) };
+        if (!childGC) { continue; }
+
+        const FTopLevelAssetPath childPath{ childGC->GetClassPathName() };
+        if (State.ChildActorsInProgress.Contains(childPath))
+        {
+            ++State.ChildActorCyclesCut;
+
+            FCompactChildActorResult& cycle{ OutChildActors.AddDefaulted_GetRef() };
+            cycle.ComponentName = childActorComp->GetFName();
+            cycle.ChildActorClass = childGC;
+            cycle.IsCycle = true;
+            continue;
+        }
+
+        FCompactBlueprintResult uncachedResult{};
+        const FCompactBlueprintResult& childResult{ EvaluateChildActorClass(childGC, State, uncachedResult) };
+        const bool hasAnything{
+            !childResult.QueriedComponents.IsEmpty() || !childResult.TransitiveIssues.IsEmpty() || !childResult.ChildActors.IsEmpty()
+        };
+        if (!hasAnything) { continue; }
+
+        const int32 childIndex{ OutChildActors.Num() };
+        FCompactChildActorResult& entry{ OutChildActors.AddDefaulted_GetRef() };
+        entry.ComponentName = childActorComp->GetFName();
+        entry.ChildActorClass = childResult.BlueprintGC;
+        entry.QueriedComponents = childResult.QueriedComponents;
+        entry.TransitiveIssues = childResult.TransitiveIssues;
+
+        // Splice in the child's own tree one level deeper; its top level hangs off the new entry
+        const int32 offset{ OutChildActors.Num() };
+        for (const FCompactChildActorResult& nested : childResult.ChildActors)
+        {
+            FCompactChildActorResult& nestedEntry{ OutChildActors.Add_GetRef(nested) };
+            nestedEntry.ParentIndex = nested.ParentIndex == INDEX_NONE ? childIndex : nested.ParentIndex + offset;
+            nestedEntry.Depth = nested.Depth + 1;
+        }
+    }
+}
+
+const FCompactBlueprintResult& FDependencyScanner::EvaluateChildActorClass(
+UBlueprintGeneratedClass* ChildGC,
+FDependencyScanState& State,
+FCompactBlueprintResult& OutUncachedResult)
+{
+    const FTopLevelAssetPath childPath{ ChildGC->GetClassPathName() };
+    if (const FCompactBlueprintResult* cachedResult{ State.ChildActorResults.Find(childPath) }) { return *cachedResult; }
+
+    // Evaluation marks the class as in progress itself
+    const int32 cyclesCutBefore{ State.ChildActorCyclesCut };
+    EvaluateBlueprint(ChildGC, OutUncachedResult, &State);
+
+    if (State.ChildActorCyclesCut != cyclesCutBefore) { return OutUncachedResult; }
+    return State.ChildActorResults.Add(childPath, MoveTemp(OutUncachedResult));
+}
+
+TArray<FAssetData> FDependencyScanner::GetAllBlueprintAssets()
+{
+    return GetBlueprintAssets({});
+}
+
+TArray<FAssetData> FDependencyScanner::GetBlueprintAssets(const FDependencyQueryScope& Scope)
+{
+    const IAssetRegistry& assetRegistry{ FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get() };
+
+    FARFilter filter{};
+    filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+    filter.PackagePaths = Scope.PackagePaths;
+    filter.bRecursivePaths = true;
+
+    // Empty filter lists don't restrict anything, so scopes that resolve to nothing have to bail out instead
+    if (!Scope.Collections.IsEmpty())
+    {
+        ICollectionManager& collectionManager{ FCollectionManagerModule::GetModule().Get() };
+        for (const FName& collection : Scope.Collections)
+        {
+            collectionManager.GetObjectsInCollection(
+            collection,
+            ECollectionShareType::CST_All,
+            filter.SoftObjectPaths,
+            ECollectionRecursionFlags::SelfAndChildren);
+        }
+
+        if (filter.SoftObjectPaths.IsEmpty()) { return {}; }
+    }
+
+    // Only set when the scope's parent class is a blueprint class: the classes deriving from it, itself included
+    TOptional<TSet<FTopLevelAssetPath>> blueprintClasses{};
+    if (Scope.NativeParentClass)
+    {
+        UClass* nativeParent{ Scope.NativeParentClass.Get() };
+        while (nativeParent && !nativeParent->HasAnyClassFlags(CLASS_Native)) { nativeParent = nativeParent->GetSuperClass(); }
+
+        // Blueprints store their closest native parent as a tag, so derived native classes are listed explicitly.
+        // A blueprint parent narrows it down to its own native parent first, then to its subclasses below.
+        TArray<UClass*> nativeClasses{ nativeParent };
+        if (nativeParent == Scope.NativeParentClass.Get()) { GetDerivedClasses(nativeParent, nativeClasses); }
+        else
+        {
+            TSet<FTopLevelAssetPath> derivedClasses{};
+            assetRegistry.GetDerivedClassNames({ Scope.NativeParentClass->GetClassPathName() }, {}, derivedClasses);
+            derivedClasses.Add(Scope.NativeParentClass->GetClassPathName());
+            blueprintClasses = MoveTemp(derivedClasses);
+        }
+
+        for (const UClass* nativeClass : nativeClasses)
+        {
+            if (!nativeClass->HasAnyClassFlags(CLASS_Native)) { continue; }
+            filter.TagsAndValues.Add(FBlueprintTags::NativeParentClassPath, FObjectPropertyBase::GetExportPath(nativeClass));
+        }
+    }
+
+    if (Scope.OpenOrDirtyOnly)
+    {
+        TSet<FName> packageNames{};
+        if (GEditor)
+        {
+            for (const UObject* asset : GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->GetAllEditedAssets())
+            {
+                packageNames.Add(asset->GetPackage()->GetFName());
+            }
+        }
+
+        TArray<UPackage*> dirtyPackages{};
+        FEditorFileUtils::GetDirtyContentPackages(dirtyPackages);
+        for (const UPackage* package : dirtyPackages)
+        {
+            packageNames.Add(package->GetFName());
+        }
+
+        if (packageNames.IsEmpty()) { return {}; }
+        filter.PackageNames = packageNames.Array();
+    }
+
+    TArray<FAssetData> assetDataList;
+    assetRegistry.GetAssets(filter, assetDataList);
+
+    if (blueprintClasses.IsSet())
+    {
+        assetDataList.RemoveAll([&blueprintClasses](const FAssetData& AssetData)
+        {
+            const FString generatedClass{ AssetData.GetTagValueRef<FString>(FBlueprintTags::GeneratedClassPath) };
+            return !blueprintClasses->Contains(FTopLevelAssetPath{ FPackageName::ExportTextPathToObjectPath(generatedClass) });
+        });
+    }
+    return assetDataList;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,273 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CompDep/Public/ComponentDependencyStructs.h"
+#include "FDependencyUtils.h"
+#include "TransitiveDependencyGraph.h"
+#include "DependencyScanner.generated.h"
+
+// Result types for low-memory scans; they only reference classes softly, so nothing
+// evaluated is kept alive by the results themselves.
+
+USTRUCT(BlueprintType)
+struct FCompactDependencyResult
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    EComponentDependencyPosition Position{};
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TSoftClassPtr<UActorComponent> Class{};
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FName Meta{};
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    EComponentDependencyType Type{ EComponentDependencyType::Required };
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FGameplayTagQuery TagQuery{};
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool IsFulfilled{ false };
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool ShowDependency{ false };
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FString OutputString{};
+
+    // The tag this dependency matches against; for tag query positions, the query's description
+    FString GetTagString() const
+    {
+        const bool isQuery{
+            Position == EComponentDependencyPosition::AnyOnActorWithTagQuery || Position == EComponentDependencyPosition::ChildWithTagQuery
+        };
+        return isQuery ? TagQuery.GetDescription() : Meta.ToString();
+    }
+};
+
+USTRUCT(BlueprintType)
+struct FCompactComponentResult
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FName ComponentName{};
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TSoftClassPtr<UActorComponent> ComponentClass{};
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FCompactDependencyResult> QueriedDependencies;
+
+    int GetUnfulfilledDependencyCount() const
+    {
+        int count{};
+        for (const FCompactDependencyResult& res : QueriedDependencies)
+        {
+            if (res.Type == EComponentDependencyType::Optional) { continue; }
+            if (!res.IsFulfilled) { ++count; }
+        }
+        return count;
+    }
+};
+
+// One child actor in a blueprint's child actor tree. USTRUCTs can't contain themselves, so the tree is
+// stored flat, parents before their children.
+USTRUCT(BlueprintType)
+struct FCompactChildActorResult
+{
+    GENERATED_BODY()
+
+    // The ChildActorComponent spawning this child actor, on its parent
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FName ComponentName{};
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TSoftClassPtr<AActor> ChildActorClass{};
+
+    // Index of the parent child actor, or INDEX_NONE if it's spawned by the evaluated blueprint itself
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 ParentIndex{ INDEX_NONE };
+
+    // 0 for child actors of the evaluated blueprint itself
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 Depth{};
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FCompactComponentResult> QueriedComponents;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FTransitiveDependencyIssue> TransitiveIssues;
+
+    // Set if this child actor class (indirectly) spawns itself; the entry isn't evaluated any further
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool IsCycle{ false };
+
+    int GetUnfulfilledDependencyCount() const
+    {
+        int count{ TransitiveIssues.Num() + (IsCycle ? 1 : 0) };
+        for (const FCompactComponentResult& res : QueriedComponents)
+        {
+            count += res.GetUnfulfilledDependencyCount();
+        }
+        return count;
+    }
+};
+
+USTRUCT(BlueprintType)
+struct FCompactBlueprintResult
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TSoftClassPtr<AActor> BlueprintGC{};
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FCompactComponentResult> QueriedComponents;
+
+    // Only filled when transitive checks are enabled in UCompDepSettings
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FTransitiveDependencyIssue> TransitiveIssues;
+
+    // Child actors (and theirs) with dependencies, each evaluated on its own
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FCompactChildActorResult> ChildActors;
+
+    int GetUnfulfilledDependencyCount() const
+    {
+        int count{ TransitiveIssues.Num() };
+        for (const FCompactComponentResult& res : QueriedComponents)
+        {
+            count += res.GetUnfulfilledDependencyCount();
+        }
+        for (const FCompactChildActorResult& res : ChildActors)
+        {
+            count += res.GetUnfulfilledDependencyCount();
+        }
+        return count;
+    }
+
+    // Path of ChildActorComponent names from the blueprint down to the child actor, e.g. "Turret/Barrel"
+    FString GetChildActorPath(int32 Index) const
+    {
+        FString path{ ChildActors[Index].ComponentName.ToString() };
+        for (int32 parent{ ChildActors[Index].ParentIndex }; parent != INDEX_NONE; parent = ChildActors[parent].ParentIndex)
+        {
+            path = ChildActors[parent].ComponentName.ToString() + TEXT("/") + path;
+        }
+        return path;
+    }
+};
+
+// Narrows a query down through the asset registry before anything is loaded. Every scope that's set
+// has to match; within one scope, matching any entry is enough.
+USTRUCT(BlueprintType)
+struct FDependencyQueryScope
+{
+    GENERATED_BODY()
+
+    // Content folders such as "/Game/Features/Combat", including their subfolders
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FName> PackagePaths;
+
+    // Including their child collections
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FName> Collections;
+
+    // Only blueprints deriving from this class; for a blueprint class, the class itself is included
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TSubclassOf<AActor> NativeParentClass;
+
+    // Only blueprints that are open in an asset editor or have unsaved changes
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool OpenOrDirtyOnly{ false };
+};
+
+// Shared by all blueprints of one scan. Apart from the context cache, which checks its classes are
+// still alive, it only holds class paths and results, so it stays valid when scans collect garbage between batches.
+struct FDependencyScanState
+{
+    FDependencyResultCache ResultCache{};
+    // Contexts of every owning class evaluated so far, so parents shared by many blueprints are gathered and hashed once
+    FDependencyContextCache ContextCache{};
+    // Only set when transitive checks are enabled
+    TOptional<FTransitiveDependencyGraph> TransitiveGraph{};
+
+    // Child actor classes are evaluated once, however many blueprints spawn them
+    TMap<FTopLevelAssetPath, FCompactBlueprintResult> ChildActorResults{};
+    // Guards against child actor classes that (indirectly) spawn themselves
+    TSet<FTopLevelAssetPath> ChildActorsInProgress{};
+    // Counts cycles cut so far; results that cut one depend on where evaluation started, so they aren't memoized
+    int32 ChildActorCyclesCut{};
+
+    // Packages loaded by the state's own blueprint loads, dependencies included; the only ones a scan may release
+    TSet<TWeakObjectPtr<UPackage>> LoadedPackages{};
+};
+
+/*
+ * Evaluates blueprint assets in batches, handing out compact results as it goes. After each batch, if
+ * memory grew past the configured budget (UCompDepSettings) since the scan started, the packages the scan
+ * loaded itself are released and garbage is collected; full scans stay inside a fixed working set.
+ * Packages that were already loaded, or are open or dirty, are never released.
+ * Results are memoized by structural signature, and child actor results per class, until the next release.
+ */
+class FDependencyScanner
+{
+public:
+    using FOnBlueprintEvaluated = TFunctionRef<void(const FCompactBlueprintResult& Result)>;
+    // Called once per component that declares dependencies, with one result per dependency
+    using FOnComponentEvaluated = TFunctionRef<void(
+    UActorComponent* Component,
+    const TArray<FComponentDependency>& Dependencies,
+    const TArray<FDependencyFulfilledResult>& Results)>;
+
+    // Marks a stretch of bulk evaluation, so asset load and dirty events it causes aren't mistaken for user edits
+    struct FScanScope
+    {
+        FScanScope();
+        ~FScanScope();
+    };
+
+    static bool IsScanning();
+
+    static void Scan(const TArray<FAssetData>& Assets, FOnBlueprintEvaluated OnEvaluated);
+
+    // Returns false if the asset is not an actor blueprint or has nothing with dependencies, child actors included.
+    // Blueprints evaluated with the same state share results when their component structure is identical.
+    static bool EvaluateBlueprint(const FAssetData& AssetData, FCompactBlueprintResult& OutResult, FDependencyScanState* State = nullptr);
+    static bool EvaluateBlueprint(UBlueprintGeneratedClass* BlueprintGC, FCompactBlueprintResult& OutResult, FDependencyScanState* State = nullptr);
+
+    // The evaluation behind every query, compact or not: the components' own dependencies, transitive
+    // issues and child actors. Returns false if the class is not an actor blueprint.
+    static bool EvaluateBlueprintComponents(
+    UBlueprintGeneratedClass* BlueprintGC,
+    FDependencyScanState& State,
+    FOnComponentEvaluated OnComponentEvaluated,
+    TArray<FTransitiveDependencyIssue>& OutTransitiveIssues,
+    TArray<FCompactChildActorResult>& OutChildActors);
+
+    // Recurses into the child actor classes of the given ChildActorComponents; other components are skipped
+    static void EvaluateChildActors(
+    const TArray<UActorComponent*>& Components,
+    TArray<FCompactChildActorResult>& OutChildActors,
+    FDependencyScanState& State);
+
+    // Evaluates a child actor class once per state and returns the memoized result. Results that cut a
+    // cycle aren't memoized; they're written to OutUncachedResult and returned from there.
+    static const FCompactBlueprintResult& EvaluateChildActorClass(
+    UBlueprintGeneratedClass* ChildGC,
+    FDependencyScanState& State,
+    FCompactBlueprintResult& OutUncachedResult);
+
+    static TArray<FAssetData> GetAllBlueprintAssets();
+    static TArray<FAssetData> GetBlueprintAssets(const FDependencyQueryScope& Scope);
+
+private:
+    // Also drops the state's memoized results, so they can't outgrow the memory budget either
+    static void ReleaseLoadedPackages(FDependencyScanState& State);
+
+    static int32 ActiveScans;
+};
@@ -0,0 +1,393 @@
+#include "DependencyValidationSubsystem.h"
+
+#include "CompDepSettings.h"
+#include "DependencyScanner.h"
+#include "Editor.h"
+#include "MessageLogModule.h"
+#include "Components/ChildActorComponent.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Logging/MessageLog.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "UObject/UObjectHash.h"
+
+#define LOCTEXT_NAMESPACE "DependencyValidation"
+
+const FName UDependencyValidationSubsystem::MessageLogName{ TEXT("CompDep") };
+
+namespace
+{
+    // Adds the blueprint classes of child actors spawned by the class, at any depth, children before their parents
+    void GatherChildActorClasses(
+    const UBlueprintGeneratedClass* BlueprintGC,
+    const FDependencyScanState& State,
+    TSet<const UBlueprintGeneratedClass*>& Visited,
+    TArray<TWeakObjectPtr<UBlueprintGeneratedClass>>& OutClasses)
+    {
+        for (const UActorComponent* component : FDependencyUtils::GetAllBlueprintComponentsByName(BlueprintGC))
+        {
+            const UChildActorComponent* childActor{ Cast<UChildActorComponent>(component) };
+            UBlueprintGeneratedClass* childGC{ childActor ? Cast<UBlueprintGeneratedClass>(childActor->GetChildActorClass()) : nullptr };
+            if (!childGC || Visited.Contains(childGC)) { continue; }
+
+            // Memoized classes have their whole subtree memoized as well
+            Visited.Add(childGC);
+            if (State.ChildActorResults.Contains(childGC->GetClassPathName())) { continue; }
+
+            GatherChildActorClasses(childGC, State, Visited, OutClasses);
+            OutClasses.Add(childGC);
+        }
+    }
+
+    // Adds the blueprint parents, component classes and child actor classes of the class, following child actors
+    void GatherUsedClasses(const UClass* Class, TSet<const UClass*>& Visited, TSet<FTopLevelAssetPath>& OutClasses)
+    {
+        for (const UClass* current{ Class }; current && !current->HasAnyClassFlags(CLASS_Native); current = current->GetSuperClass())
+        {
+            OutClasses.Add(current->GetClassPathName());
+        }
+
+        const UBlueprintGeneratedClass* blueprintGC{ Cast<UBlueprintGeneratedClass>(Class) };
+        if (!blueprintGC) { return; }
+
+        for (const UActorComponent* component : FDependencyUtils::GetAllBlueprintComponentsByName(blueprintGC))
+        {
+            OutClasses.Add(component->GetClass()->GetClassPathName());
+
+            const UChildActorComponent* childActor{ Cast<UChildActorComponent>(component) };
+            const UClass* childClass{ childActor ? childActor->GetChildActorClass().Get() : nullptr };
+            if (!childClass || Visited.Contains(childClass)) { continue; }
+
+            Visited.Add(childClass);
+            GatherUsedClasses(childClass, Visited, OutClasses);
+        }
+    }
+}
+
+void UDependencyValidationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    FMessageLogModule& messageLog{ FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog") };
+    FMessageLogInitializationOptions options{};
+    options.bShowPages = true;
+    options.bAllowClear = true;
+    messageLog.RegisterLogListing(MessageLogName, LOCTEXT("MessageLogLabel", "Component Dependencies"), options);
+
+    PackageDirtyHandle = UPackage::PackageMarkedDirtyEvent.AddUObject(this, &UDependencyValidationSubsystem::OnPackageMarkedDirty);
+
+    // Only assets the user actually opens are of interest; plain loads mostly come from scans and references
+    UAssetEditorSubsystem* assetEditors{ Collection.InitializeDependency<UAssetEditorSubsystem>() };
+    AssetOpenedHandle = assetEditors->OnAssetOpenedInEditor().AddUObject(this, &UDependencyValidationSubsystem::OnAssetOpened);
+
+    if (GEditor)
+    {
+        BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddUObject(this, &UDependencyValidationSubsystem::OnBlueprintPreCompile);
+    }
+}
+
+void UDependencyValidationSubsystem::Deinitialize()
+{
+    UPackage::PackageMarkedDirtyEvent.Remove(PackageDirtyHandle);
+
+    if (GEditor)
+    {
+        if (UAssetEditorSubsystem* assetEditors{ GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() })
+        {
+            assetEditors->OnAssetOpenedInEditor().Remove(AssetOpenedHandle);
+        }
+        GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+    }
+
+    if (FModuleManager::Get().IsModuleLoaded("MessageLog"))
+    {
+        FModuleManager::GetModuleChecked<FMessageLogModule>("MessageLog").UnregisterLogListing(MessageLogName);
+    }
+
+    Queue.Empty();
+    QueuedBlueprints.Empty();
+    CurrentBlueprint.Reset();
+    PendingChildActorClasses.Empty();
+    ValidationState = {};
+    UsedClasses.Empty();
+    Dependents.Empty();
+
+    Super::Deinitialize();
+}
+
+void UDependencyValidationSubsystem::EnqueueBlueprint(UBlueprint* Blueprint)
+{
+    if (!Blueprint) { return; }
+
+    // Only actor blueprints hold components to validate
+    if (!Blueprint->ParentClass || !Blueprint->ParentClass->IsChildOf(AActor::StaticClass())) { return; }
+
+    if (QueuedBlueprints.Contains(Blueprint)) { return; }
+
+    QueuedBlueprints.Add(Blueprint);
+    Queue.Add(Blueprint);
+}
+
+void UDependencyValidationSubsystem::Tick(float DeltaTime)
+{
+    if (!IsEditorIdle()) { return; }
+
+    const double budgetSeconds{ GetDefault<UCompDepSettings>()->BackgroundValidationBudgetMs / 1000.0 };
+    const double startTime{ FPlatformTime::Seconds() };
+
+    // Always do at least one slice per tick so the queue keeps moving
+    while (IsTickable())
+    {
+        ValidateNextSlice();
+
+        if (FPlatformTime::Seconds() - startTime >= budgetSeconds) { break; }
+    }
+}
+
+bool UDependencyValidationSubsystem::IsTickable() const
+{
+    const bool hasWork{ !Queue.IsEmpty() || CurrentBlueprint.IsValid() };
+    return hasWork && GetDefault<UCompDepSettings>()->EnableBackgroundValidation;
+}
+
+TStatId UDependencyValidationSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UDependencyValidationSubsystem, STATGROUP_Tickables);
+}
+
+void UDependencyValidationSubsystem::OnPackageMarkedDirty(UPackage* Package, bool WasDirty)
+{
+    if (ShouldIgnoreChanges() || Package == GetTransientPackage()) { return; }
+
+    bool hasBlueprint{ false };
+    ForEachObjectWithPackage(Package, [this, &hasBlueprint](UObject* Object)
+    {
+        if (UBlueprint* blueprint{ Cast<UBlueprint>(Object) })
+        {
+            hasBlueprint = true;
+            EnqueueBlueprint(blueprint);
+        }
+        return true;
+    }, false);
+
+    // Edited templates change results without changing any class, so memoized child actor results are stale
+    if (hasBlueprint) { ResetValidationState(); }
+}
+
+void UDependencyValidationSubsystem::OnAssetOpened(UObject* Asset, IAssetEditorInstance* AssetEditor)
+{
+    if (ShouldIgnoreChanges()) { return; }
+
+    EnqueueBlueprint(Cast<UBlueprint>(Asset));
+}
+
+void UDependencyValidationSubsystem::OnBlueprintPreCompile(const UBlueprint* Blueprint)
+{
+    if (!Blueprint || Blueprint->bIsRegeneratingOnLoad || ShouldIgnoreChanges()) { return; }
+    if (Blueprint->GetPackage() == GetTransientPackage()) { return; }
+
+    // Declarations and components of the compiled class may change; nothing memoized about it can be trusted
+    ResetValidationState();
+    EnqueueDependents(Blueprint);
+}
+
+void UDependencyValidationSubsystem::EnqueueDependents(const UBlueprint* Blueprint)
+{
+    const UClass* changedClass{ Blueprint->GeneratedClass };
+    if (!changedClass) { return; }
+
+    // Results of child blueprints, and of blueprints holding the changed component or child actor, are stale now.
+    // Blueprints that weren't validated yet get queued when they're opened or edited.
+    TSet<TWeakObjectPtr<UBlueprint>>* dependents{ Dependents.Find(changedClass->GetClassPathName()) };
+    if (!dependents) { return; }
+
+    for (auto it{ dependents->CreateIterator() }; it; ++it)
+    {
+        UBlueprint* blueprint{ it->Get() };
+        if (!blueprint)
+        {
+            it.RemoveCurrent();
+            continue;
+        }
+
+        if (blueprint != Blueprint) { EnqueueBlueprint(blueprint); }
+    }
+}
+
+void UDependencyValidationSubsystem::IndexDependencies(UBlueprint* Blueprint)
+{
+    TSet<FTopLevelAssetPath> usedClasses{};
+    TSet<const UClass*> visited{};
+    GatherUsedClasses(Blueprint->GeneratedClass, visited, usedClasses);
+
+    TSet<FTopLevelAssetPath>& indexed{ UsedClasses.FindOrAdd(Blueprint) };
+    for (const FTopLevelAssetPath& classPath : indexed.Difference(usedClasses))
+    {
+        if (TSet<TWeakObjectPtr<UBlueprint>>* dependents{ Dependents.Find(classPath) })
+        {
+            dependents->Remove(Blueprint);
+            if (dependents->IsEmpty()) { Dependents.Remove(classPath); }
+        }
+    }
+    for (const FTopLevelAssetPath& classPath : usedClasses)
+    {
+        Dependents.FindOrAdd(classPath).Add(Blueprint);
+    }
+    indexed = MoveTemp(usedClasses);
+}
+
+void UDependencyValidationSubsystem::ResetValidationState()
+{
+    ValidationState = {};
+    if (GetDefault<UCompDepSettings>()->EnableTransitiveChecks) { ValidationState.TransitiveGraph.Emplace(); }
+}
+
+bool UDependencyValidationSubsystem::ShouldIgnoreChanges() const
+{
+    return IsRunningCommandlet() || GIsCookerLoadingPackage || GIsEditorLoadingPackage || FDependencyScanner::IsScanning();
+}
+
+bool UDependencyValidationSubsystem::IsEditorIdle() const
+{
+    if (!GEditor || GEditor->IsPlaySessionInProgress()) { return false; }
+    if (IsAsyncLoading() || IsGarbageCollecting()) { return false; }
+    if (!FSlateApplication::IsInitialized()) { return false; }
+
+    const FSlateApplication& slate{ FSlateApplication::Get() };
+    const double idleTime{ slate.GetCurrentTime() - slate.GetLastUserInteractionTime() };
+    return idleTime >= GetDefault<UCompDepSettings>()->BackgroundValidationIdleDelay;
+}
+
+void UDependencyValidationSubsystem::ValidateNextSlice()
+{
+    UBlueprint* blueprint{ CurrentBlueprint.Get() };
+    if (!blueprint)
+    {
+        const TWeakObjectPtr<UBlueprint> next{ Queue[0] };
+        Queue.RemoveAt(0, 1, EAllowShrinking::No);
+        QueuedBlueprints.Remove(next);
+
+        blueprint = next.Get();
+        const UBlueprintGeneratedClass* blueprintGC{ blueprint ? Cast<UBlueprintGeneratedClass>(blueprint->GeneratedClass) : nullptr };
+        if (!blueprintGC) { return; }
+
+        // Picking the next blueprint is its own slice, since it walks the whole child actor tree
+        if (ValidationState.TransitiveGraph.IsSet() != GetDefault<UCompDepSettings>()->EnableTransitiveChecks) { ResetValidationState(); }
+        TSet<const UBlueprintGeneratedClass*> visited{ blueprintGC };
+        PendingChildActorClasses.Reset();
+        GatherChildActorClasses(blueprintGC, ValidationState, visited, PendingChildActorClasses);
+        CurrentBlueprint = blueprint;
+        return;
+    }
+
+    // Children come first, so each child actor class finds its own child actors memoized
+    while (!PendingChildActorClasses.IsEmpty())
+    {
+        UBlueprintGeneratedClass* childGC{ PendingChildActorClasses[0].Get() };
+        PendingChildActorClasses.RemoveAt(0, 1, EAllowShrinking::No);
+        if (!childGC) { continue; }
+
+        FCompactBlueprintResult uncachedResult{};
+        FDependencyScanner::EvaluateChildActorClass(childGC, ValidationState, uncachedResult);
+        return;
+    }
+
+    CurrentBlueprint.Reset();
+    ValidateBlueprint(blueprint);
+}
+
+void UDependencyValidationSubsystem::ValidateBlueprint(UBlueprint* Blueprint)
+{
+    const FSoftObjectPath blueprintPath{ Blueprint };
+    IndexDependencies(Blueprint);
+
+    FCompactBlueprintResult result{};
+    if (!FDependencyScanner::EvaluateBlueprint(Cast<UBlueprintGeneratedClass>(Blueprint->GeneratedClass), result, &ValidationState))
+    {
+        // No components with dependencies (anymore); nothing can be violated
+        KnownViolations.Remove(blueprintPath);
+        return;
+    }
+
+    PublishViolations(blueprintPath, result);
+}
+
+void UDependencyValidationSubsystem::PublishViolations(const FSoftObjectPath& BlueprintPath, const FCompactBlueprintResult& Result)
+{
+    TSet<FString>& known{ KnownViolations.FindOrAdd(BlueprintPath) };
+    TSet<FString> current{};
+
+    FMessageLog log{ MessageLogName };
+    bool publishedAny{ false };
+
+    auto publish{ [&current, &known, &log, &publishedAny, &BlueprintPath](const FString& Violation)
+    {
+        current.Add(Violation);
+        if (known.Contains(Violation)) { return; }
+
+        if (!publishedAny)
+        {
+            log.NewPage(FText::FromString(BlueprintPath.GetAssetName()));
+            publishedAny = true;
+        }
+
+        log.Warning()
+           ->AddToken(FAssetNameToken::Create(BlueprintPath.ToString()))
+           ->AddToken(FTextToken::Create(FText::FromString(Violation)));
+    } };
+
+    // Problems on child actors are prefixed with the child actor's path, e.g. "Turret/Barrel > Health: ..."
+    auto publishComponents{ [&publish](
+    const FString& Prefix,
+    const TArray<FCompactComponentResult>& Components,
+    const TArray<FTransitiveDependencyIssue>& TransitiveIssues)
+    {
+        for (const FCompactComponentResult& component : Components)
+        {
+            for (const FCompactDependencyResult& dependency : component.QueriedDependencies)
+            {
+                if (!dependency.ShowDependency || dependency.IsFulfilled) { continue; }
+                if (dependency.Type == EComponentDependencyType::Optional) { continue; }
+
+                publish(FString::Printf(
+                TEXT("%s%s: %s (%s, tag '%s'): %s"),
+                *Prefix,
+                *component.ComponentName.ToString(),
+                *dependency.Class.GetAssetName(),
+                *StaticEnum<EComponentDependencyPosition>()->GetNameStringByValue(static_cast<int64>(dependency.Position)),
+                *dependency.GetTagString(),
+                *dependency.OutputString));
+            }
+        }
+
+        for (const FTransitiveDependencyIssue& issue : TransitiveIssues)
+        {
+            publish(FString::Printf(TEXT("%s%s: %s"), *Prefix, *issue.ComponentName.ToString(), *issue.OutputString));
+        }
+    } };
+
+    publishComponents({}, Result.QueriedComponents, Result.TransitiveIssues);
+
+    for (int32 i{}; i < Result.ChildActors.Num(); ++i)
+    {
+        const FCompactChildActorResult& childActor{ Result.ChildActors[i] };
+        const FString childActorPath{ Result.GetChildActorPath(i) };
+        if (childActor.IsCycle)
+        {
+            publish(FString::Printf(TEXT("%s: %s spawns itself through its child actors"), *childActorPath, *childActor.ChildActorClass.GetAssetName()));
+            continue;
+        }
+
+        publishComponents(childActorPath + TEXT(" > "), childActor.QueriedComponents, childActor.TransitiveIssues);
+    }
+
+    // Fixed violations are forgotten, so they get reported again if they ever come back
+    known = MoveTemp(current);
+
+    if (publishedAny)
+    {
+        log.Notify(LOCTEXT("NewViolations", "New component dependency problems found"), EMessageSeverity::Warning);
+    }
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DependencyScanner.h"
+#include "EditorSubsystem.h"
+#include "TickableEditorObject.h"
+#include "DependencyValidationSubsystem.generated.h"
+
+class IAssetEditorInstance;
+
+/*
+ * Keeps dependency status up to date without anyone opening the viewer. Blueprints the user opens or edits
+ * are queued, then evaluated in small slices while the editor is idle, within the per-frame budget set in
+ * UCompDepSettings. A slice is one class: each child actor class of a queued blueprint gets its own slice,
+ * deepest first, before the blueprint itself. Compiling a blueprint also requeues the already validated
+ * blueprints that inherit from or use it. Loads and edits caused by scans, cooks and commandlets are ignored.
+ * Violations that weren't reported before, child actors and transitive issues included, are published to
+ * the CompDep message log.
+ */
+UCLASS()
+class UDependencyValidationSubsystem : public UEditorSubsystem, public FTickableEditorObject
+{
+    GENERATED_BODY()
+
+public:
+    static const FName MessageLogName;
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    void EnqueueBlueprint(UBlueprint* Blueprint);
+
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+private:
+    void OnPackageMarkedDirty(UPackage* Package, bool WasDirty);
+    void OnAssetOpened(UObject* Asset, IAssetEditorInstance* AssetEditor);
+    void OnBlueprintPreCompile(const UBlueprint* Blueprint);
+
+    void EnqueueDependents(const UBlueprint* Blueprint);
+    void IndexDependencies(UBlueprint* Blueprint);
+    void ResetValidationState();
+
+    bool ShouldIgnoreChanges() const;
+    bool IsEditorIdle() const;
+    // Evaluates one class: the next pending child actor class of the current blueprint, or the blueprint itself
+    void ValidateNextSlice();
+    void ValidateBlueprint(UBlueprint* Blueprint);
+    void PublishViolations(const FSoftObjectPath& BlueprintPath, const FCompactBlueprintResult& Result);
+
+    TArray<TWeakObjectPtr<UBlueprint>> Queue{};
+    TSet<TWeakObjectPtr<UBlueprint>> QueuedBlueprints{};
+
+    // The blueprint being validated, and its child actor classes that still need a slice, deepest first
+    TWeakObjectPtr<UBlueprint> CurrentBlueprint{};
+    TArray<TWeakObjectPtr<UBlueprintGeneratedClass>> PendingChildActorClasses{};
+
+    // Shared by all validations until something is compiled or edited, so child actor classes and identical
+    // structures are only evaluated once; holds the transitive graph when transitive checks are enabled
+    FDependencyScanState ValidationState{};
+
+    // Classes each validated blueprint inherits from, holds as components or spawns as child actors, at any
+    // depth; and the reverse, to find the blueprints to requeue when one of those classes is compiled
+    TMap<TWeakObjectPtr<UBlueprint>, TSet<FTopLevelAssetPath>> UsedClasses{};
+    TMap<FTopLevelAssetPath, TSet<TWeakObjectPtr<UBlueprint>>> Dependents{};
+
+    // Violations already published per blueprint, so each one is only reported once until it's fixed
+    TMap<FSoftObjectPath, TSet<FString>> KnownViolations{};
+
+    FDelegateHandle PackageDirtyHandle{};
+    FDelegateHandle AssetOpenedHandle{};
+    FDelegateHandle BlueprintPreCompileHandle{};
+};
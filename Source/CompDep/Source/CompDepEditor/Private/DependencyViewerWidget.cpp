@@ -2,87 +2,179 @@
 
 #include "DependencyViewerWidget.h"
 
+#include "CompDepSettings.h"
 #include "ComponentDependencies.h"
 #include "FDependencyUtils.h"
 #include "ObjectTools.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Kismet/KismetSystemLibrary.h"
 
-TArray<FQueryDependencyBlueprintResult> UDependencyViewerWidget::QueryBlueprints(FString Filter, bool ShowOnlyUnfulfilled)
+namespace
 {
-    TArray<FQueryDependencyBlueprintResult> queryResult{ QueryBlueprintsInternal() };
-
-    if (!Filter.IsEmpty())
-    {
-        queryResult = queryResult.FilterByPredicate([&Filter](const FQueryDependencyBlueprintResult& Result)
-        {
-            return UKismetSystemLibrary::GetClassDisplayName(Result.BlueprintGC).Contains(Filter);
-        });
-    }
-
-    if (ShowOnlyUnfulfilled)
+    // Drops results without problems and puts the ones with the most problems first
+    template <typename TResult>
+    void KeepUnfulfilled(TArray<TResult>& Results)
     {
-        queryResult = queryResult.FilterByPredicate([&Filter](const FQueryDependencyBlueprintResult& Result)
+        Results.RemoveAll([](const TResult& Result)
         {
-            return Result.GetUnfulfilledDependencyCount() > 0;
+            return Result.GetUnfulfilledDependencyCount() == 0;
         });
 
-        queryResult.Sort([](const FQueryDependencyBlueprintResult& A, const FQueryDependencyBlueprintResult& B)
+        Results.Sort([](const TResult& A, const TResult& B)
         {
             return A.GetUnfulfilledDependencyCount() > B.GetUnfulfilledDependencyCount();
         });
     }
 
-    return queryResult;
+    void FilterResults(TArray<FQueryDependencyBlueprintResult>& Results, const FString& Filter, bool ShowOnlyUnfulfilled)
+    {
+        if (!Filter.IsEmpty())
+        {
+            Results.RemoveAll([&Filter](const FQueryDependencyBlueprintResult& Result)
+            {
+                return !UKismetSystemLibrary::GetClassDisplayName(Result.BlueprintGC).Contains(Filter);
+            });
+        }
+
+        if (ShowOnlyUnfulfilled) { KeepUnfulfilled(Results); }
+    }
 }
 
-TArray<FQueryDependencyBlueprintResult> UDependencyViewerWidget::QueryBlueprintsInternal()
+TArray<FQueryDependencyBlueprintResult> UDependencyViewerWidget::QueryBlueprints(FString Filter, bool ShowOnlyUnfulfilled)
 {
-    const FAssetRegistryModule& assetRegistry{ FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry") };
-
-    TArray<FAssetData> assetDataList;
-    assetRegistry.Get().GetAssetsByClass(UBlueprint::StaticClass()->GetClassPathName(), assetDataList);
+    return QueryBlueprintsInScope(GetDefault<UCompDepSettings>()->ViewerScope, Filter, ShowOnlyUnfulfilled);
+}
 
+TArray<FQueryDependencyBlueprintResult> UDependencyViewerWidget::QueryBlueprintsInternal(const TArray<FAssetData>& AssetDataList)
+{
     TArray<FQueryDependencyBlueprintResult> blueprintResults{};
+    const FDependencyScanner::FScanScope scanScope{};
+    // Child blueprints mostly share their parent's component structure; evaluate each structure once
+    FDependencyScanState state{};
+    if (GetDefault<UCompDepSettings>()->EnableTransitiveChecks) { state.TransitiveGraph.Emplace(); }
 
-    for (const FAssetData& assetData : assetDataList)
+    for (const FAssetData& assetData : AssetDataList)
     {
         const UBlueprint* blueprintAsset{ Cast<UBlueprint>(assetData.GetAsset()) };
         if (!blueprintAsset) { continue; }
 
-        UBlueprintGeneratedClass* blueprintGC{ Cast<UBlueprintGeneratedClass>(blueprintAsset->GeneratedClass) };
-        if (!blueprintGC) { continue; }
+        FQueryDependencyBlueprintResult blueprintResult{};
+        blueprintResult.BlueprintGC = Cast<UBlueprintGeneratedClass>(blueprintAsset->GeneratedClass);
 
-        if (!blueprintGC->IsChildOf(AActor::StaticClass())) { continue; }
+        const bool isActorBlueprint{ FDependencyScanner::EvaluateBlueprintComponents(
+        blueprintResult.BlueprintGC,
+        state,
+        [&blueprintResult](UActorComponent* Component, const TArray<FComponentDependency>& Dependencies, const TArray<FDependencyFulfilledResult>& Results)
+        {
+            FQueryDependencyComponentResult& componentResult{ blueprintResult.QueriedComponents.AddDefaulted_GetRef() };
+            componentResult.Component = Component;
+            for (int32 i{}; i < Dependencies.Num(); ++i)
+            {
+                componentResult.QueriedDependencies.Emplace(Dependencies[i], Results[i]);
+            }
+        },
+        blueprintResult.TransitiveIssues,
+        blueprintResult.ChildActors) };
 
-        TArray<FQueryDependencyComponentResult> componentResults{};
+        if (!isActorBlueprint) { continue; }
+        if (blueprintResult.QueriedComponents.IsEmpty() && blueprintResult.ChildActors.IsEmpty()) { continue; }
 
-        TArray<UActorComponent*> components{ FDependencyUtils::GetAllBlueprintComponentsByName(blueprintGC) };
-        for (UActorComponent* innerComp : components)
+        blueprintResults.Add(MoveTemp(blueprintResult));
+    }
+
+    return blueprintResults;
+}
+
+bool UDependencyViewerWidget::ExpandCompactResult(const FCompactBlueprintResult& CompactResult, FQueryDependencyBlueprintResult& OutResult)
+{
+    OutResult.BlueprintGC = Cast<UBlueprintGeneratedClass>(CompactResult.BlueprintGC.LoadSynchronous());
+    if (!OutResult.BlueprintGC) { return false; }
+
+    TMap<FName, UActorComponent*> components{};
+    for (UActorComponent* component : FDependencyUtils::GetAllBlueprintComponentsByName(OutResult.BlueprintGC))
+    {
+        components.Add(component->GetFName(), component);
+    }
+
+    for (const FCompactComponentResult& compactComponent : CompactResult.QueriedComponents)
+    {
+        UActorComponent* component{ components.FindRef(compactComponent.ComponentName) };
+        if (!component) { continue; }
+
+        FQueryDependencyComponentResult& componentResult{ OutResult.QueriedComponents.AddDefaulted_GetRef() };
+        componentResult.Component = component;
+
+        for (const FCompactDependencyResult& compactDependency : compactComponent.QueriedDependencies)
         {
-            if (!innerComp->GetClass()->ImplementsInterface(UComponentDependencies::StaticClass())) { continue; }
-            TArray<FQueryDependencyResult> dependencyResults{};
+            FQueryDependencyResult& dependencyResult{ componentResult.QueriedDependencies.AddDefaulted_GetRef() };
+            dependencyResult.Dependency.Position = compactDependency.Position;
+            dependencyResult.Dependency.Class = compactDependency.Class.Get();
+            dependencyResult.Dependency.SoftClass = compactDependency.Class;
+            dependencyResult.Dependency.Meta = compactDependency.Meta;
+            dependencyResult.Dependency.Type = compactDependency.Type;
+            dependencyResult.Dependency.TagQuery = compactDependency.TagQuery;
+            dependencyResult.FulfilledResult = { compactDependency.IsFulfilled, compactDependency.ShowDependency, compactDependency.OutputString };
+        }
+    }
 
-            TArray<FComponentDependency> dependencies{ IComponentDependencies::Execute_GetDependencies(innerComp) };
-            for (FComponentDependency& dependency : dependencies)
-            {
-                dependencyResults.Emplace(
-                dependency,
-                FDependencyUtils::CheckDependency(innerComp, dependency));
-            }
+    OutResult.TransitiveIssues = CompactResult.TransitiveIssues;
+    OutResult.ChildActors = CompactResult.ChildActors;
+    return true;
+}
 
-            if (dependencyResults.IsEmpty()) { continue; }
-            componentResults.Emplace(
-            innerComp,
-            MoveTemp(dependencyResults));
+TArray<FQueryDependencyBlueprintResult> UDependencyViewerWidget::QueryBlueprintsInScope(
+const FDependencyQueryScope& Scope,
+FString Filter,
+bool ShowOnlyUnfulfilled)
+{
+    if (GetDefault<UCompDepSettings>()->ViewerLowMemoryQueries)
+    {
+        // Filtered and sorted while scanning already; with ShowOnlyUnfulfilled, only problem blueprints come back
+        TArray<FQueryDependencyBlueprintResult> queryResult{};
+        for (const FCompactBlueprintResult& compactResult : QueryBlueprintsLowMemory(Scope, Filter, ShowOnlyUnfulfilled))
+        {
+            FQueryDependencyBlueprintResult blueprintResult{};
+            if (ExpandCompactResult(compactResult, blueprintResult)) { queryResult.Add(MoveTemp(blueprintResult)); }
         }
+        return queryResult;
+    }
 
-        if (componentResults.IsEmpty()) { continue; }
+    TArray<FQueryDependencyBlueprintResult> queryResult{ QueryBlueprintsInternal(FDependencyScanner::GetBlueprintAssets(Scope)) };
+    FilterResults(queryResult, Filter, ShowOnlyUnfulfilled);
+    return queryResult;
+}
+
+TArray<FCompactBlueprintResult> UDependencyViewerWidget::QueryBlueprintsLowMemory(
+const FDependencyQueryScope& Scope,
+FString Filter,
+bool ShowOnlyUnfulfilled)
+{
+    TArray<FAssetData> assetDataList{ FDependencyScanner::GetBlueprintAssets(Scope) };
 
-        blueprintResults.Emplace(blueprintGC, MoveTemp(componentResults));
+    // Filter before loading anything; the generated class is named after its blueprint asset
+    if (!Filter.IsEmpty())
+    {
+        assetDataList = assetDataList.FilterByPredicate([&Filter](const FAssetData& AssetData)
+        {
+            return (AssetData.AssetName.ToString() + TEXT("_C")).Contains(Filter);
+        });
     }
 
-    return blueprintResults;
+    TArray<FCompactBlueprintResult> queryResult{};
+    FDependencyScanner::Scan(assetDataList, [&queryResult, ShowOnlyUnfulfilled](const FCompactBlueprintResult& Result)
+    {
+        // Dropped right away, so fulfilled results are never held at all
+        if (ShowOnlyUnfulfilled && Result.GetUnfulfilledDependencyCount() == 0) { return; }
+        queryResult.Add(Result);
+    });
+
+    if (ShowOnlyUnfulfilled) { KeepUnfulfilled(queryResult); }
+    return queryResult;
+}
+
+bool UDependencyViewerWidget::ExportDependencyGraph(FString FilePath, EDependencyGraphExportFormat Format)
+{
+    return FDependencyGraphExporter::Export(FilePath, Format);
 }
 
 UTexture2D* UDependencyViewerWidget::GetThumbnail(const UBlueprintGeneratedClass* BlueprintGC, int Size)
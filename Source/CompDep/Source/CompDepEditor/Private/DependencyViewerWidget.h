@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "DependencyGraphExporter.h"
+#include "DependencyScanner.h"
 #include "FDependencyUtils.h"
 #include "Editor/Blutility/Classes/EditorUtilityWidget.h"
 #include "DependencyViewerWidget.generated.h"
@@ -52,13 +54,24 @@ struct FQueryDependencyBlueprintResult
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     TArray<FQueryDependencyComponentResult> QueriedComponents;
 
+    // Only filled when transitive checks are enabled in UCompDepSettings
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FTransitiveDependencyIssue> TransitiveIssues;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FCompactChildActorResult> ChildActors;
+
     int GetUnfulfilledDependencyCount() const
     {
-        int count{};
+        int count{ TransitiveIssues.Num() };
         for (const FQueryDependencyComponentResult& res : QueriedComponents)
         {
             count += res.GetUnfulfilledDependencyCount();
         }
+        for (const FCompactChildActorResult& res : ChildActors)
+        {
+            count += res.GetUnfulfilledDependencyCount();
+        }
         return count;
     }
 };
@@ -69,9 +82,31 @@ class COMPDEPEDITOR_API UDependencyViewerWidget : public UEditorUtilityWidget
     GENERATED_BODY()
 
 protected:
+    // Queries the scope set under the viewer settings (UCompDepSettings::ViewerScope)
     UFUNCTION(BlueprintCallable)
     static TArray<FQueryDependencyBlueprintResult> QueryBlueprints(FString Filter = "", bool ShowOnlyUnfulfilled = false);
-    static TArray<FQueryDependencyBlueprintResult> QueryBlueprintsInternal();
+    static TArray<FQueryDependencyBlueprintResult> QueryBlueprintsInternal(const TArray<FAssetData>& AssetDataList);
+    // Loads the blueprint of a low-memory result again and resolves its components; false if it's gone
+    static bool ExpandCompactResult(const FCompactBlueprintResult& CompactResult, FQueryDependencyBlueprintResult& OutResult);
+
+    // Only loads and evaluates blueprints inside the given scope
+    UFUNCTION(BlueprintCallable, meta = (AutoCreateRefTerm = "Scope"))
+    static TArray<FQueryDependencyBlueprintResult> QueryBlueprintsInScope(
+    const FDependencyQueryScope& Scope,
+    FString Filter = "",
+    bool ShowOnlyUnfulfilled = false);
+
+    // Same as QueryBlueprintsInScope, but results only hold soft references and blueprints are released
+    // in batches while scanning; use this on projects too large to keep every blueprint loaded.
+    // An empty scope queries the whole project.
+    UFUNCTION(BlueprintCallable, meta = (AutoCreateRefTerm = "Scope"))
+    static TArray<FCompactBlueprintResult> QueryBlueprintsLowMemory(
+    const FDependencyQueryScope& Scope,
+    FString Filter = "",
+    bool ShowOnlyUnfulfilled = false);
+
+    UFUNCTION(BlueprintCallable)
+    static bool ExportDependencyGraph(FString FilePath, EDependencyGraphExportFormat Format = EDependencyGraphExportFormat::JsonLines);
 
     UFUNCTION(BlueprintCallable)
     static UTexture2D* GetThumbnail(const UBlueprintGeneratedClass* BlueprintGC, int Size = 64);
@@ -1,5 +1,6 @@
 ﻿#include "FDependencyUtils.h"
 
+#include "Engine/Blueprint.h"
 #include "Engine/InheritableComponentHandler.h"
 #include "Engine/SCS_Node.h"
 #include "Engine/SimpleConstructionScript.h"
@@ -22,7 +23,7 @@ FDependencyFulfilledResult FDependencyUtils::GetDependencyResult(
 const UActorComponent* SourceComponent,
 const FComponentDependency& Dependency)
 {
-    if (Dependency.Class == nullptr) { return { false, false, "No class given!" }; }
+    if (!Dependency.HasClass()) { return { false, false, "No class given!" }; }
 
     UObject* outer{ SourceComponent->GetOuter() };
     UClass* outerClass{ outer->GetClass() };
@@ -74,7 +75,9 @@ const FComponentDependency& Dependency)
     }
 
     const bool dependencyNeedsTree{
-        Dependency.Position == EComponentDependencyPosition::Child || Dependency.Position == EComponentDependencyPosition::ChildWithTag
+        Dependency.Position == EComponentDependencyPosition::Child
+        || Dependency.Position == EComponentDependencyPosition::ChildWithTag
+        || Dependency.Position == EComponentDependencyPosition::ChildWithTagQuery
     };
     if (dependencyNeedsTree && !componentSCSNode)
     {
@@ -91,7 +94,7 @@ const FComponentDependency& Dependency)
     {
         for (const TObjectPtr<UActorComponent>& innerComp : componentList)
         {
-            if (!innerComp->IsA(Dependency.Class)) { continue; }
+            if (!Dependency.IsSatisfiedByClass(innerComp->GetClass())) { continue; }
 
             return { true, true, "Present" };
         }
@@ -106,7 +109,7 @@ const FComponentDependency& Dependency)
 
         for (const TObjectPtr<UActorComponent>& innerComp : componentList)
         {
-            const bool isType{ innerComp->IsA(Dependency.Class) };
+            const bool isType{ Dependency.IsSatisfiedByClass(innerComp->GetClass()) };
             const bool hasTag{ innerComp->ComponentHasTag(Dependency.Meta) };
 
             if (isType) { containsAnyWithType = true; }
@@ -134,7 +137,7 @@ const FComponentDependency& Dependency)
         {
             if (!node) { continue; }
 
-            if (!node->ComponentTemplate->IsA(Dependency.Class)) { continue; }
+            if (!Dependency.IsSatisfiedByClass(node->ComponentTemplate->GetClass())) { continue; }
             anyOfType = true;
 
             if (!node->IsChildOf(componentSCSNode)) { continue; }
@@ -157,7 +160,7 @@ const FComponentDependency& Dependency)
             if (!node) { continue; }
             if (!node->ComponentTemplate) { continue; }
 
-            const bool correctType{ node->ComponentTemplate->IsA(Dependency.Class) };
+            const bool correctType{ Dependency.IsSatisfiedByClass(node->ComponentTemplate->GetClass()) };
             const bool correctTag{ node->ComponentTemplate->ComponentHasTag(Dependency.Meta) };
             const bool isChild{ node->IsChildOf(componentSCSNode) };
 
@@ -180,6 +183,486 @@ const FComponentDependency& Dependency)
         }
         return { false, true, "Not Present" };
     }
+    if (Dependency.Position == EComponentDependencyPosition::AnyOnActorWithTagQuery)
+    {
+        bool containsAnyMatching{ false };
+        bool containsAnyWithType{ false };
+
+        for (const TObjectPtr<UActorComponent>& innerComp : componentList)
+        {
+            const bool isType{ Dependency.IsSatisfiedByClass(innerComp->GetClass()) };
+            const bool matches{ Dependency.TagQuery.Matches(GetComponentGameplayTags(innerComp)) };
+
+            if (isType && matches) { return { true, true, "Present matching Tag Query" }; }
+
+            if (isType) { containsAnyWithType = true; }
+            if (matches) { containsAnyMatching = true; }
+        }
+
+        if (containsAnyWithType) { return { false, true, "Correct Type, Tags don't match Query" }; }
+        if (containsAnyMatching) { return { false, true, "Wrong Type, Tags match Query" }; }
+
+        return { false, true, "Not Present" };
+    }
+    if (Dependency.Position == EComponentDependencyPosition::ChildWithTagQuery)
+    {
+        if (!componentSCSNode) { return { false, true, "Couldn't locate SCS node!" }; }
+
+        bool containsAnyMatchingWithType{ false };
+        bool containsChildWithCorrectType{ false };
+
+        for (const auto& [name, node] : nodes)
+        {
+            if (!node) { continue; }
+            if (!node->ComponentTemplate) { continue; }
+
+            const bool correctType{ Dependency.IsSatisfiedByClass(node->ComponentTemplate->GetClass()) };
+            const bool matches{ Dependency.TagQuery.Matches(GetComponentGameplayTags(node->ComponentTemplate)) };
+            const bool isChild{ node->IsChildOf(componentSCSNode) };
+
+            if (correctType && matches && isChild) { return { true, true, "Present as Child" }; }
+
+            if (correctType && matches) { containsAnyMatchingWithType = true; }
+            if (correctType && isChild) { containsChildWithCorrectType = true; }
+        }
+
+        if (containsAnyMatchingWithType) { return { false, true, "Exists, Not as Child" }; }
+        if (containsChildWithCorrectType) { return { false, true, "Child Exists, Tags don't match Query" }; }
+        return { false, true, "Not Present" };
+    }
+
+    return { false, true, "Unknown error! Is your dependency type valid?" };
+}
+
+FDependencyFulfilledResult FDependencyUtils::CheckDependency(
+const FDependencyEvaluationContext& Context,
+const UActorComponent* SourceComponent,
+const FComponentDependency& Dependency)
+{
+    FDependencyFulfilledResult result{ GetDependencyResult(Context, SourceComponent, Dependency) };
+
+    if (Dependency.Type == EComponentDependencyType::Optional && !result.IsFulfilled)
+    {
+        result.OutputString = "Not Present; Optional";
+    }
+
+    return result;
+}
+
+FSHAHash FDependencyResultCache::ComputeStructuralSignature(const FDependencyEvaluationContext& Context)
+{
+    FSHA1 sha{};
+    auto addString{ [&sha](const FString& Value)
+    {
+        // Length prefix, so neighbouring strings can't blend into each other
+        const int32 length{ Value.Len() };
+        sha.Update(reinterpret_cast<const uint8*>(&length), sizeof(length));
+        sha.UpdateWithString(*Value, length);
+    } };
+    auto addTemplate{ [&addString](const UActorComponent* Component)
+    {
+        addString(Component ? Component->GetClass()->GetPathName() : FString{});
+        addString(FString::FromInt(Component ? Component->ComponentTags.Num() : 0));
+        if (!Component) { return; }
+        for (const FName& tag : Component->ComponentTags)
+        {
+            addString(tag.ToString());
+        }
+    } };
+
+    addString(Context.HasActorCDO ? TEXT("cdo") : TEXT("no_cdo"));
+    addString(Context.HasConstructionScript ? TEXT("scs") : TEXT("no_scs"));
+
+    // Components are only ever searched as a whole, so their order doesn't matter
+    TArray<const UActorComponent*> sortedComponents{ Context.Components };
+    sortedComponents.Sort([](const UActorComponent& A, const UActorComponent& B)
+    {
+        return A.GetFName().LexicalLess(B.GetFName());
+    });
+
+    addString(FString::FromInt(sortedComponents.Num()));
+    for (const UActorComponent* component : sortedComponents)
+    {
+        addString(component->GetName());
+        addTemplate(component);
+    }
+
+    // The SCS trees decide which nodes are found and which are children of which
+    int32 level{};
+    for (UClass* curClass{ Context.BlueprintGC }; curClass; curClass = curClass->GetSuperClass(), ++level)
+    {
+        const UBlueprintGeneratedClass* bpClass{ Cast<UBlueprintGeneratedClass>(curClass) };
+        if (!bpClass || !bpClass->SimpleConstructionScript) { continue; }
+
+        const TArray<USCS_Node*>& nodes{ bpClass->SimpleConstructionScript->GetAllNodes() };
+        TMap<const USCS_Node*, const USCS_Node*> parents{};
+        for (const USCS_Node* node : nodes)
+        {
+            for (const USCS_Node* child : node->GetChildNodes())
+            {
+                parents.Add(child, node);
+            }
+        }
+
+        addString(FString::Printf(TEXT("level %d: %d"), level, nodes.Num()));
+        for (const USCS_Node* node : nodes)
+        {
+            const USCS_Node* parent{ parents.FindRef(node) };
+            addString(node->ComponentTemplate ? node->ComponentTemplate->GetName() : FString{});
+            addString(parent && parent->ComponentTemplate ? parent->ComponentTemplate->GetName() : FString{});
+            addTemplate(node->ComponentTemplate);
+        }
+    }
+
+    sha.Final();
+    FSHAHash result{};
+    sha.GetHash(result.Hash);
+    return result;
+}
+
+FDependencyFulfilledResult FDependencyResultCache::CheckDependency(
+const FDependencyEvaluationContext& Context,
+const FSHAHash& StructuralSignature,
+const UActorComponent* SourceComponent,
+const FComponentDependency& Dependency)
+{
+    const FQueryKey key{
+        SourceComponent->GetFName(),
+        SourceComponent->IsA<USceneComponent>(),
+        Dependency.Position,
+        Dependency.GetClassPath(),
+        Dependency.Meta,
+        Dependency.Type,
+        Dependency.TagQuery,
+    };
+
+    TMap<FQueryKey, FDependencyFulfilledResult>& structureResults{ Results.FindOrAdd(StructuralSignature) };
+    if (const FDependencyFulfilledResult* cached{ structureResults.Find(key) })
+    {
+        ++HitCount;
+        return *cached;
+    }
+
+    ++MissCount;
+    return structureResults.Add(key, FDependencyUtils::CheckDependency(Context, SourceComponent, Dependency));
+}
+
+FDependencyContextCache::FEntry& FDependencyContextCache::FindOrAdd(UBlueprintGeneratedClass* BlueprintGC)
+{
+    FEntry& entry{ Entries.FindOrAdd(BlueprintGC->GetClassPathName()) };
+    if (entry.BlueprintGC.Get() != BlueprintGC)
+    {
+        entry = { BlueprintGC, FDependencyUtils::MakeEvaluationContext(BlueprintGC) };
+    }
+    return entry;
+}
+
+FDependencyFulfilledResult FDependencyEvaluationBatch::CheckDependency(
+const UActorComponent* SourceComponent,
+const FComponentDependency& Dependency)
+{
+    UBlueprintGeneratedClass* blueprintGC{ FDependencyUtils::GetOwningBlueprintClass(SourceComponent) };
+    // Without an owning blueprint there's nothing to batch; the reference reports why
+    if (!blueprintGC) { return FDependencyUtils::CheckDependency(SourceComponent, Dependency); }
+
+    FDependencyContextCache::FEntry& cached{ Contexts.FindOrAdd(blueprintGC) };
+    if (!Cache) { return FDependencyUtils::CheckDependency(cached.Context, SourceComponent, Dependency); }
+
+    if (!cached.StructuralSignature.IsSet())
+    {
+        cached.StructuralSignature = FDependencyResultCache::ComputeStructuralSignature(cached.Context);
+    }
+    return Cache->CheckDependency(cached.Context, cached.StructuralSignature.GetValue(), SourceComponent, Dependency);
+}
+
+FDependencyEvaluationContext FDependencyUtils::MakeEvaluationContext(UBlueprintGeneratedClass* BlueprintGC)
+{
+    FDependencyEvaluationContext context{};
+    context.BlueprintGC = BlueprintGC;
+    if (!BlueprintGC) { return context; }
+
+    context.HasActorCDO = BlueprintGC->GetDefaultObject<AActor>() != nullptr;
+    context.HasConstructionScript = BlueprintGC->SimpleConstructionScript != nullptr;
+    context.Components = GetAllBlueprintComponentsByName(BlueprintGC);
+
+    GatherConstructionScriptNodes(context);
+    return context;
+}
+
+FDependencyEvaluationContext FDependencyUtils::MakeCompilationContext(UBlueprintGeneratedClass* BlueprintGC)
+{
+    FDependencyEvaluationContext context{};
+    context.BlueprintGC = BlueprintGC;
+    if (!BlueprintGC) { return context; }
+
+    // The CDO may not be regenerated yet; actor classes always get one
+    context.HasActorCDO = BlueprintGC->IsChildOf(AActor::StaticClass());
+    context.HasConstructionScript = BlueprintGC->SimpleConstructionScript != nullptr;
+
+    GatherConstructionScriptNodes(context);
+
+    // Nodes holds the most derived node per name; the actual template applies this class's overrides
+    for (const auto& [name, node] : context.Nodes)
+    {
+        if (UActorComponent* compTemplate{ node->GetActualComponentTemplate(BlueprintGC) })
+        {
+            context.Components.Add(compTemplate);
+        }
+    }
+
+    // Natively added components come from the closest parent whose CDO is compiled, so overrides parent
+    // blueprints make to them (e.g. ComponentTags) apply; this class's own CDO isn't regenerated yet
+    const AActor* parentCDO{};
+    for (UClass* parent{ BlueprintGC->GetSuperClass() }; parent && !parentCDO; parent = parent->GetSuperClass())
+    {
+        const UBlueprint* parentBlueprint{ UBlueprint::GetBlueprintFromClass(parent) };
+        if (parentBlueprint && parentBlueprint->bBeingCompiled) { continue; }
+
+        parentCDO = Cast<AActor>(parent->GetDefaultObject(false));
+    }
+
+    if (parentCDO)
+    {
+        TArray<UActorComponent*> nativeComps{};
+        parentCDO->GetComponents<UActorComponent>(nativeComps);
+
+        for (UActorComponent* innerComp : nativeComps)
+        {
+            if (context.Nodes.Contains(innerComp->GetFName())) { continue; }
+            context.Components.Add(innerComp);
+        }
+    }
+
+    return context;
+}
+
+void FDependencyUtils::GatherConstructionScriptNodes(FDependencyEvaluationContext& Context)
+{
+    for (UClass* curClass{ Context.BlueprintGC }; curClass; curClass = curClass->GetSuperClass())
+    {
+        const UBlueprintGeneratedClass* bpClass{ Cast<UBlueprintGeneratedClass>(curClass) };
+        if (!bpClass) { continue; }
+
+        const USimpleConstructionScript* scs{ bpClass->SimpleConstructionScript };
+        if (!scs) { continue; }
+
+        for (USCS_Node* node : scs->GetAllNodes())
+        {
+            const FName currentName{ node->ComponentTemplate->GetFName() };
+            if (!Context.Nodes.Contains(currentName)) { Context.Nodes.Add(currentName, node); }
+
+            // Overwritten on purpose; the least derived match wins, same as in GetDependencyResult
+            Context.SourceNodes.Add(currentName, node);
+        }
+    }
+}
+
+void FDependencyUtils::UpdateGameplayTags(FDependencyEvaluationContext& Context)
+{
+    Context.GameplayTags.Reset();
+}
+
+FGameplayTagContainer FDependencyUtils::GetComponentGameplayTags(const UActorComponent* Component)
+{
+    FGameplayTagContainer container{};
+    if (!Component) { return container; }
+
+    // Tags that aren't registered gameplay tags can never match a query, so they're skipped
+    for (const FName& tag : Component->ComponentTags)
+    {
+        const FGameplayTag gameplayTag{ FGameplayTag::RequestGameplayTag(tag, false) };
+        if (gameplayTag.IsValid()) { container.AddTag(gameplayTag); }
+    }
+
+    return container;
+}
+
+UBlueprintGeneratedClass* FDependencyUtils::GetOwningBlueprintClass(const UActorComponent* Component)
+{
+    if (!Component) { return nullptr; }
+
+    // Blueprint-added components are outered to the generated class, C++-added ones to the CDO
+    UObject* outer{ Component->GetOuter() };
+    if (UBlueprintGeneratedClass * outerCast{ Cast<UBlueprintGeneratedClass>(outer) }) { return outerCast; }
+    return Cast<UBlueprintGeneratedClass>(outer->GetClass());
+}
+
+bool FDependencyUtils::IsTagDependency(const FComponentDependency& Dependency)
+{
+    return Dependency.Position == EComponentDependencyPosition::AnyOnActorWithTag
+        || Dependency.Position == EComponentDependencyPosition::ChildWithTag
+        || Dependency.Position == EComponentDependencyPosition::AnyOnActorWithTagQuery
+        || Dependency.Position == EComponentDependencyPosition::ChildWithTagQuery;
+}
+
+FDependencyFulfilledResult FDependencyUtils::GetDependencyResult(
+const FDependencyEvaluationContext& Context,
+const UActorComponent* SourceComponent,
+const FComponentDependency& Dependency)
+{
+    // Mirrors the single-shot GetDependencyResult step for step, including every failure message;
+    // only the blueprint traversal is taken from the context instead of being redone.
+    if (!Dependency.HasClass()) { return { false, false, "No class given!" }; }
+
+    UBlueprintGeneratedClass* blueprintGC{ GetOwningBlueprintClass(SourceComponent) };
+    if (!blueprintGC) { return { false, false, "Cannot find outer of class! Are you editing a blueprint?" }; }
+    check(blueprintGC == Context.BlueprintGC);
+
+    if (!Context.HasActorCDO) { return { false, true, "Actor CDO not found! Are you editing a blueprint?" }; }
+    if (!Context.HasConstructionScript) { return { false, true, "Construction Script not found! Are you editing a blueprint?" }; }
+
+    USCS_Node* componentSCSNode{};
+    if (SourceComponent->IsA<USceneComponent>())
+    {
+        componentSCSNode = Context.SourceNodes.FindRef(SourceComponent->GetFName());
+        if (!componentSCSNode)
+        {
+            return { false, true, TEXT("Are you editing a blueprint?") };
+        }
+    }
+
+    const bool dependencyNeedsTree{
+        Dependency.Position == EComponentDependencyPosition::Child
+        || Dependency.Position == EComponentDependencyPosition::ChildWithTag
+        || Dependency.Position == EComponentDependencyPosition::ChildWithTagQuery
+    };
+    if (dependencyNeedsTree && !componentSCSNode)
+    {
+        return {
+            false,
+            true,
+            "Cannot have child dependency on an ActorComponent! Use a SceneComponent instead."
+        };
+    }
+
+    if (Dependency.Position == EComponentDependencyPosition::AnyOnActor)
+    {
+        for (const UActorComponent* innerComp : Context.Components)
+        {
+            if (!Dependency.IsSatisfiedByClass(innerComp->GetClass())) { continue; }
+
+            return { true, true, "Present" };
+        }
+
+        return { false, true, "Not Present" };
+    }
+    if (Dependency.Position == EComponentDependencyPosition::AnyOnActorWithTag)
+    {
+        bool containsAnyWithTag{ false };
+        bool containsAnyWithType{ false };
+
+        for (const UActorComponent* innerComp : Context.Components)
+        {
+            const bool isType{ Dependency.IsSatisfiedByClass(innerComp->GetClass()) };
+            const bool hasTag{ innerComp->ComponentHasTag(Dependency.Meta) };
+
+            if (isType && hasTag) { return { true, true, "Present with Tag" }; }
+
+            if (isType) { containsAnyWithType = true; }
+            if (hasTag) { containsAnyWithTag = true; }
+        }
+
+        if (containsAnyWithType) { return { false, true, "Correct Type, Wrong Tag" }; }
+        if (containsAnyWithTag) { return { false, true, "Wrong Type, Correct Tag" }; }
+
+        return { false, true, "Not Present" };
+    }
+    if (Dependency.Position == EComponentDependencyPosition::Child)
+    {
+        bool anyOfType{ false };
+        for (const auto& [name, node] : Context.Nodes)
+        {
+            if (!node) { continue; }
+
+            if (!Dependency.IsSatisfiedByClass(node->ComponentTemplate->GetClass())) { continue; }
+            anyOfType = true;
+
+            if (!node->IsChildOf(componentSCSNode)) { continue; }
+
+            return { true, true, "Present as Child" };
+        }
+
+        if (anyOfType) { return { false, true, "Exists, not as child" }; }
+        return { false, true, "Not Present" };
+    }
+    if (Dependency.Position == EComponentDependencyPosition::ChildWithTag)
+    {
+        bool containsAnyWithTagAndType{ false };
+        bool containsChildWithCorrectType{ false };
+
+        for (const auto& [name, node] : Context.Nodes)
+        {
+            if (!node) { continue; }
+            if (!node->ComponentTemplate) { continue; }
+
+            const bool correctType{ Dependency.IsSatisfiedByClass(node->ComponentTemplate->GetClass()) };
+            const bool correctTag{ node->ComponentTemplate->ComponentHasTag(Dependency.Meta) };
+            const bool isChild{ node->IsChildOf(componentSCSNode) };
+
+            if (correctType && correctTag && isChild) { return { true, true, "Present as Child" }; }
+
+            if (correctType && correctTag) { containsAnyWithTagAndType = true; }
+            if (correctType && isChild) { containsChildWithCorrectType = true; }
+        }
+
+        if (containsAnyWithTagAndType) { return { false, true, "Exists, Not as Child" }; }
+        if (containsChildWithCorrectType) { return { false, true, "Child Exists, Wrong Tag" }; }
+        return { false, true, "Not Present" };
+    }
+
+    // Converted on first use; most contexts never see a tag query
+    auto matchesQuery{ [&Context, &Dependency](const UActorComponent* Component)
+    {
+        const FGameplayTagContainer* tags{ Context.GameplayTags.Find(Component) };
+        if (!tags) { tags = &Context.GameplayTags.Add(Component, GetComponentGameplayTags(Component)); }
+        return Dependency.TagQuery.Matches(*tags);
+    } };
+
+    if (Dependency.Position == EComponentDependencyPosition::AnyOnActorWithTagQuery)
+    {
+        bool containsAnyMatching{ false };
+        bool containsAnyWithType{ false };
+
+        for (const UActorComponent* innerComp : Context.Components)
+        {
+            const bool isType{ Dependency.IsSatisfiedByClass(innerComp->GetClass()) };
+            const bool matches{ matchesQuery(innerComp) };
+
+            if (isType && matches) { return { true, true, "Present matching Tag Query" }; }
+
+            if (isType) { containsAnyWithType = true; }
+            if (matches) { containsAnyMatching = true; }
+        }
+
+        if (containsAnyWithType) { return { false, true, "Correct Type, Tags don't match Query" }; }
+        if (containsAnyMatching) { return { false, true, "Wrong Type, Tags match Query" }; }
+
+        return { false, true, "Not Present" };
+    }
+    if (Dependency.Position == EComponentDependencyPosition::ChildWithTagQuery)
+    {
+        bool containsAnyMatchingWithType{ false };
+        bool containsChildWithCorrectType{ false };
+
+        for (const auto& [name, node] : Context.Nodes)
+        {
+            if (!node) { continue; }
+            if (!node->ComponentTemplate) { continue; }
+
+            const bool correctType{ Dependency.IsSatisfiedByClass(node->ComponentTemplate->GetClass()) };
+            const bool matches{ matchesQuery(node->ComponentTemplate) };
+            const bool isChild{ node->IsChildOf(componentSCSNode) };
+
+            if (correctType && matches && isChild) { return { true, true, "Present as Child" }; }
+
+            if (correctType && matches) { containsAnyMatchingWithType = true; }
+            if (correctType && isChild) { containsChildWithCorrectType = true; }
+        }
+
+        if (containsAnyMatchingWithType) { return { false, true, "Exists, Not as Child" }; }
+        if (containsChildWithCorrectType) { return { false, true, "Child Exists, Tags don't match Query" }; }
+        return { false, true, "Not Present" };
+    }
 
     return { false, true, "Unknown error! Is your dependency type valid?" };
 }
@@ -188,15 +671,19 @@ FText FDependencyUtils::GetDependencyDescriptionText(const FComponentDependency&
 {
     const bool isOptional{ Dependency.Type == EComponentDependencyType::Optional };
     const bool isChild{
-        Dependency.Position == EComponentDependencyPosition::Child || Dependency.Position == EComponentDependencyPosition::ChildWithTag
+        Dependency.Position == EComponentDependencyPosition::Child
+        || Dependency.Position == EComponentDependencyPosition::ChildWithTag
+        || Dependency.Position == EComponentDependencyPosition::ChildWithTagQuery
     };
-    const bool needsTag{
-        Dependency.Position == EComponentDependencyPosition::AnyOnActorWithTag || Dependency.Position == EComponentDependencyPosition::ChildWithTag
+    const bool needsQuery{
+        Dependency.Position == EComponentDependencyPosition::AnyOnActorWithTagQuery || Dependency.Position == EComponentDependencyPosition::ChildWithTagQuery
     };
+    const bool needsTag{ IsTagDependency(Dependency) };
 
     FString optionalText{ TEXT("Optional ") };
     FString childText{ TEXT("Child ") };
     FString tagText{ FString::Printf(TEXT(" (Tag '%s')"), *Dependency.Meta.ToString()) };
+    if (needsQuery) { tagText = FString::Printf(TEXT(" (Tag Query '%s')"), *Dependency.TagQuery.GetDescription()); }
     FText dependencyText{ FText::Format(
     NSLOCTEXT("CompDep", "DependencyText", "{0}{1}Dependency{2}"),
     {
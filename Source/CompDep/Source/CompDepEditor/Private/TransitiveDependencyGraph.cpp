@@ -0,0 +1,154 @@
+#include "TransitiveDependencyGraph.h"
+
+#include "CompDep/Public/ComponentDependencies.h"
+
+void FTransitiveDependencyGraph::FindIssues(const TArray<UActorComponent*>& Components, TArray<FTransitiveDependencyIssue>& OutIssues)
+{
+    TArray<TPair<const UActorComponent*, int32>> sources{};
+    for (const UActorComponent* component : Components)
+    {
+        if (!component->GetClass()->ImplementsInterface(UComponentDependencies::StaticClass())) { continue; }
+
+        FComponentDependency self{};
+        self.SoftClass = TSoftClassPtr<UActorComponent>{ FSoftObjectPath{ component->GetClass() } };
+        sources.Emplace(component, EnsureNode(self));
+    }
+
+    if (sources.IsEmpty()) { return; }
+    ExpandLoadedNodes();
+
+    // Presence is only resolved for classes some source needs, and only once per blueprint
+    TBitArray<> needed{ false, Nodes.Num() };
+    for (const TPair<const UActorComponent*, int32>& source : sources)
+    {
+        needed.CombineWithBitwiseOR(Nodes[source.Value].Closure, EBitwiseOperatorFlags::MaxSize);
+    }
+
+    TBitArray<> present{ false, Nodes.Num() };
+    for (TConstSetBitIterator<> it{ needed }; it; ++it)
+    {
+        const FComponentDependency& requirement{ Nodes[it.GetIndex()].Requirement };
+        for (const UActorComponent* component : Components)
+        {
+            if (!requirement.IsSatisfiedByClass(component->GetClass())) { continue; }
+
+            present[it.GetIndex()] = true;
+            break;
+        }
+    }
+
+    for (const auto& [component, nodeIndex] : sources)
+    {
+        const FNode& node{ Nodes[nodeIndex] };
+        const TSoftClassPtr<UActorComponent> componentClass{ FSoftObjectPath{ component->GetClass() } };
+
+        if (IsInClosure(nodeIndex, nodeIndex))
+        {
+            FTransitiveDependencyIssue& issue{ OutIssues.AddDefaulted_GetRef() };
+            issue.ComponentName = component->GetFName();
+            issue.ComponentClass = componentClass;
+            issue.IsCycle = true;
+            issue.OutputString = FString::Printf(TEXT("%s requires itself through its dependencies"), *component->GetClass()->GetName());
+        }
+
+        for (TConstSetBitIterator<> it{ node.Closure }; it; ++it)
+        {
+            const int32 requiredIndex{ it.GetIndex() };
+            // Direct dependencies are already reported by regular evaluation
+            if (present[requiredIndex] || requiredIndex == nodeIndex || node.Edges.Contains(requiredIndex)) { continue; }
+
+            const FComponentDependency& requirement{ Nodes[requiredIndex].Requirement };
+
+            FTransitiveDependencyIssue& issue{ OutIssues.AddDefaulted_GetRef() };
+            issue.ComponentName = component->GetFName();
+            issue.ComponentClass = componentClass;
+            issue.MissingClass = TSoftClassPtr<UActorComponent>{ FSoftObjectPath{ requirement.GetClassPath() } };
+            issue.OutputString = FString::Printf(TEXT("Indirectly requires %s; Not Present"), *requirement.GetClassName());
+        }
+    }
+}
+
+int32 FTransitiveDependencyGraph::EnsureNode(const FComponentDependency& Requirement)
+{
+    const FTopLevelAssetPath path{ Requirement.GetClassPath() };
+    if (const int32* existing{ NodeLookup.Find(path) }) { return *existing; }
+
+    const int32 index{ Nodes.AddDefaulted() };
+    NodeLookup.Add(path, index);
+    Nodes[index].Requirement.SoftClass = TSoftClassPtr<UActorComponent>{ FSoftObjectPath{ path } };
+
+    // Soft dependency classes that aren't loaded are expanded later; loading them is exactly what they avoid
+    const UClass* loadedClass{ Requirement.Class ? Requirement.Class.Get() : Requirement.SoftClass.Get() };
+    if (!loadedClass)
+    {
+        UnexpandedNodes.Add(index);
+        return index;
+    }
+
+    ExpandNode(index, loadedClass);
+    return index;
+}
+
+void FTransitiveDependencyGraph::ExpandNode(int32 Index, const UClass* Class)
+{
+    if (!Class->ImplementsInterface(UComponentDependencies::StaticClass())) { return; }
+
+    const TArray<FComponentDependency> declarations{ IComponentDependencies::Execute_GetDependencies(Class->GetDefaultObject()) };
+    for (const FComponentDependency& declaration : declarations)
+    {
+        if (declaration.Type != EComponentDependencyType::Required || !declaration.HasClass()) { continue; }
+
+        // Recursion may grow Nodes, so don't hold on to references into it
+        AddEdge(Index, EnsureNode(declaration));
+    }
+}
+
+void FTransitiveDependencyGraph::ExpandLoadedNodes()
+{
+    // Expanding can add new unexpanded nodes, which are resolved on the next call
+    const TArray<int32> pending{ MoveTemp(UnexpandedNodes) };
+
+    for (const int32 index : pending)
+    {
+        if (const UClass* loadedClass{ Nodes[index].Requirement.SoftClass.Get() })
+        {
+            ExpandNode(index, loadedClass);
+        }
+        else
+        {
+            UnexpandedNodes.Add(index);
+        }
+    }
+}
+
+void FTransitiveDependencyGraph::AddEdge(int32 From, int32 To)
+{
+    if (Nodes[From].Edges.Contains(To)) { return; }
+
+    Nodes[From].Edges.Add(To);
+    Nodes[To].ReverseEdges.Add(From);
+
+    // Everything that reaches From now also reaches To and its closure; closures that already
+    // contain all of it stop the walk, since their predecessors contain it as well
+    TBitArray<> added{ false, Nodes.Num() };
+    added[To] = true;
+    added.CombineWithBitwiseOR(Nodes[To].Closure, EBitwiseOperatorFlags::MaintainSize);
+
+    TArray<int32> pending{ From };
+    while (!pending.IsEmpty())
+    {
+        FNode& node{ Nodes[pending.Pop(EAllowShrinking::No)] };
+
+        const int32 before{ node.Closure.CountSetBits() };
+        node.Closure.CombineWithBitwiseOR(added, EBitwiseOperatorFlags::MaxSize);
+        if (node.Closure.CountSetBits() == before) { continue; }
+
+        pending.Append(node.ReverseEdges);
+    }
+}
+
+bool FTransitiveDependencyGraph::IsInClosure(int32 Index, int32 Required) const
+{
+    const TBitArray<>& closure{ Nodes[Index].Closure };
+    return Required < closure.Num() && closure[Required];
+}
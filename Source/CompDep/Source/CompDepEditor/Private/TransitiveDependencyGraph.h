@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CompDep/Public/ComponentDependencyStructs.h"
+#include "TransitiveDependencyGraph.generated.h"
+
+USTRUCT(BlueprintType)
+struct FTransitiveDependencyIssue
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FName ComponentName{};
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TSoftClassPtr<UActorComponent> ComponentClass{};
+
+    // The class required through other dependencies; empty for cycles
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TSoftClassPtr<UActorComponent> MissingClass{};
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool IsCycle{ false };
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FString OutputString{};
+};
+
+/*
+ * Declaration graph between IComponentDependencies classes: an edge A -> B means A declares a required
+ * dependency on B. Each class's transitive closure is kept as a bitset and updated incrementally: adding
+ * an edge only touches the classes that can reach it, so checking a blueprint is a few bitset operations
+ * instead of a graph walk per blueprint.
+ *
+ * Transitive requirements are checked by presence on the actor only; positions and tags of indirect
+ * dependencies depend on where the intermediate component would be added, which isn't known yet.
+ * Classes are added as they're encountered. Soft dependency classes that aren't loaded yet are never
+ * loaded by the graph; their declarations are added once something else loads them. Keep one graph per
+ * scan; recompiling a component blueprint can change its declarations.
+ */
+class FTransitiveDependencyGraph
+{
+public:
+    void FindIssues(const TArray<UActorComponent*>& Components, TArray<FTransitiveDependencyIssue>& OutIssues);
+
+private:
+    struct FNode
+    {
+        // Describes which component classes satisfy this node. Only SoftClass is set, so nodes stay
+        // valid when low-memory scans collect garbage between batches.
+        FComponentDependency Requirement{};
+        TArray<int32> Edges{};
+        TArray<int32> ReverseEdges{};
+        // Only covers the node indices that were reachable when it last changed; missing bits are unset
+        TBitArray<> Closure{};
+    };
+
+    int32 EnsureNode(const FComponentDependency& Requirement);
+    void ExpandNode(int32 Index, const UClass* Class);
+    void ExpandLoadedNodes();
+    void AddEdge(int32 From, int32 To);
+    bool IsInClosure(int32 Index, int32 Required) const;
+
+    TArray<FNode> Nodes{};
+    TMap<FTopLevelAssetPath, int32> NodeLookup{};
+    // Nodes whose class wasn't loaded yet, so their declarations are still missing
+    TArray<int32> UnexpandedNodes{};
+};
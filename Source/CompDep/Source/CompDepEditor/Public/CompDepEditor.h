@@ -12,6 +12,10 @@ private:
     void RegisterMenus();
     void PopulateSubMenu(UToolMenu* Menu);
     void OpenDependencyViewer();
+    void OpenViewerScopeSettings();
+
+    void RegisterEvaluationEngines();
+    void UnregisterEvaluationEngines();
 
     void InitializeReloadHooks();
     FDelegateHandle BlueprintPreCompileDelegateHandle;
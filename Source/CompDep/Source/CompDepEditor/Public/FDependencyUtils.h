@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "CoreMinimal.h"
+#include "Misc/SecureHash.h"
 #include "CompDep/Public/ComponentDependencyStructs.h"
 #include "FDependencyUtils.generated.h"
 
@@ -19,6 +20,135 @@ struct FDependencyFulfilledResult
     FString OutputString{};
 };
 
+class USCS_Node;
+
+// Everything about a blueprint that dependency evaluation needs, gathered once so many
+// dependencies (of many components) can be checked without re-walking the class hierarchy.
+struct FDependencyEvaluationContext
+{
+    UBlueprintGeneratedClass* BlueprintGC{};
+    bool HasActorCDO{ false };
+    bool HasConstructionScript{ false };
+
+    TArray<UActorComponent*> Components{};
+
+    // First SCS node per template name, walking from the most derived class upwards
+    TMap<FName, USCS_Node*> Nodes{};
+    // Last SCS node per template name; this is the node a source component resolves to
+    TMap<FName, USCS_Node*> SourceNodes{};
+
+    // ComponentTags of components and SCS templates as gameplay tags, parents included, so tag queries match
+    // hierarchically without scanning FName arrays per candidate. Only filled in by tag queries, as they need them.
+    mutable TMap<const UActorComponent*, FGameplayTagContainer> GameplayTags{};
+};
+
+/*
+ * Shares dependency results between blueprints with an identical component composition. Child blueprints
+ * that only change meshes or numeric defaults inherit the same component classes, tags and SCS tree, so
+ * their results are evaluated once per unique structure and looked up for every other blueprint.
+ * Keys use class paths, not pointers; keep a cache for the duration of one scan, since reparenting a
+ * component class changes results without changing its path.
+ */
+class FDependencyResultCache
+{
+public:
+    // Hash of everything evaluation reads from a context: component classes and tags, and every SCS node
+    // of the hierarchy with its template class, tags and parent. Names are included, blueprint paths aren't.
+    static FSHAHash ComputeStructuralSignature(const FDependencyEvaluationContext& Context);
+
+    FDependencyFulfilledResult CheckDependency(
+    const FDependencyEvaluationContext& Context,
+    const FSHAHash& StructuralSignature,
+    const UActorComponent* SourceComponent,
+    const FComponentDependency& Dependency);
+
+    // Drops all results; hit and miss counts keep counting
+    void Reset() { Results.Reset(); }
+
+    int32 GetHitCount() const { return HitCount; }
+    int32 GetMissCount() const { return MissCount; }
+
+private:
+    struct FQueryKey
+    {
+        FName SourceName{};
+        bool SourceIsScene{ false };
+        EComponentDependencyPosition Position{};
+        FTopLevelAssetPath Class{};
+        FName Meta{};
+        EComponentDependencyType Type{};
+        FGameplayTagQuery TagQuery{};
+
+        bool operator==(const FQueryKey& Other) const
+        {
+            return SourceName == Other.SourceName
+                && SourceIsScene == Other.SourceIsScene
+                && Position == Other.Position
+                && Class == Other.Class
+                && Meta == Other.Meta
+                && Type == Other.Type
+                && TagQuery == Other.TagQuery;
+        }
+
+        friend uint32 GetTypeHash(const FQueryKey& Key)
+        {
+            uint32 hash{ GetTypeHash(Key.SourceName) };
+            hash = HashCombine(hash, GetTypeHash(Key.SourceIsScene));
+            hash = HashCombine(hash, GetTypeHash(Key.Position));
+            hash = HashCombine(hash, GetTypeHash(Key.Class));
+            hash = HashCombine(hash, GetTypeHash(Key.Meta));
+            // Queries using the same tags only collide; equality still compares the full query
+            for (const FGameplayTag& tag : Key.TagQuery.GetGameplayTagArray())
+            {
+                hash = HashCombine(hash, GetTypeHash(tag));
+            }
+            return HashCombine(hash, GetTypeHash(Key.Type));
+        }
+    };
+
+    TMap<FSHAHash, TMap<FQueryKey, FDependencyFulfilledResult>> Results{};
+    int32 HitCount{};
+    int32 MissCount{};
+};
+
+// Evaluation contexts and their structural signatures per owning class path. Entries remember the class
+// they were built from, so a recompiled or collected class gets a new context instead of a dangling one.
+class FDependencyContextCache
+{
+public:
+    struct FEntry
+    {
+        TWeakObjectPtr<UBlueprintGeneratedClass> BlueprintGC{};
+        FDependencyEvaluationContext Context{};
+        // Only computed once a result cache needs it
+        TOptional<FSHAHash> StructuralSignature{};
+    };
+
+    FEntry& FindOrAdd(UBlueprintGeneratedClass* BlueprintGC);
+    void Reset() { Entries.Reset(); }
+
+private:
+    TMap<FTopLevelAssetPath, FEntry> Entries{};
+};
+
+// Lazily builds one evaluation context per owning blueprint class. Components inherited from a parent
+// blueprint are owned by that parent, so a single blueprint's components may need more than one context.
+// With a result cache, structurally identical blueprints reuse each other's results. Pass a context cache
+// to keep contexts beyond this batch, e.g. for a parent shared by every blueprint of a scan.
+class FDependencyEvaluationBatch
+{
+public:
+    explicit FDependencyEvaluationBatch(FDependencyResultCache* InCache = nullptr, FDependencyContextCache* InContexts = nullptr)
+        : Cache{ InCache }, Contexts{ InContexts ? *InContexts : OwnContexts } {}
+
+    FDependencyFulfilledResult CheckDependency(const UActorComponent* SourceComponent, const FComponentDependency& Dependency);
+
+private:
+    FDependencyResultCache* Cache{};
+    FDependencyContextCache OwnContexts{};
+    FDependencyContextCache& Contexts;
+};
+
 class FDependencyUtils
 {
 public:
@@ -26,11 +156,36 @@ public:
     const UActorComponent* SourceComponent,
     const FComponentDependency& Dependency);
 
+    // Batched counterpart to CheckDependency; produces identical results, but reuses the given context.
+    // The source component must be owned by Context.BlueprintGC.
+    static FDependencyFulfilledResult CheckDependency(
+    const FDependencyEvaluationContext& Context,
+    const UActorComponent* SourceComponent,
+    const FComponentDependency& Dependency);
+
+    static FDependencyEvaluationContext MakeEvaluationContext(UBlueprintGeneratedClass* BlueprintGC);
+    // For classes that are still being compiled: components are taken from the SCS templates (with the
+    // class's InheritableComponentHandler overrides) and, for native components, from the closest parent
+    // CDO that isn't being compiled itself; never from the class's own CDO
+    static FDependencyEvaluationContext MakeCompilationContext(UBlueprintGeneratedClass* BlueprintGC);
+    // Drops Context.GameplayTags after component tags were edited; they're converted again on next use
+    static void UpdateGameplayTags(FDependencyEvaluationContext& Context);
+    static FGameplayTagContainer GetComponentGameplayTags(const UActorComponent* Component);
+    static UBlueprintGeneratedClass* GetOwningBlueprintClass(const UActorComponent* Component);
+    static bool IsTagDependency(const FComponentDependency& Dependency);
+
     static FText GetDependencyDescriptionText(const FComponentDependency& Dependency);
     static TArray<UActorComponent*> GetAllBlueprintComponentsByName(const UBlueprintGeneratedClass* BlueprintClass);
 
 private:
+    static void GatherConstructionScriptNodes(FDependencyEvaluationContext& Context);
+
+    static FDependencyFulfilledResult GetDependencyResult(
+    const UActorComponent* SourceComponent,
+    const FComponentDependency& Dependency);
+
     static FDependencyFulfilledResult GetDependencyResult(
+    const FDependencyEvaluationContext& Context,
     const UActorComponent* SourceComponent,
     const FComponentDependency& Dependency);
 };